@@ -0,0 +1,217 @@
+#include "GameplayEventAggregator.h"
+#include "GameplayEventLogger.h"
+
+struct FGameplayEventAggregator::FNameState
+{
+    explicit FNameState(int32 NumBuckets)
+        : Buckets(MakeUnique<std::atomic<uint64>[]>(NumBuckets))
+    {
+        Reset(NumBuckets);
+    }
+
+    void Reset(int32 NumBuckets)
+    {
+        Total.store(0, std::memory_order_relaxed);
+        FirstSeen.store(TNumericLimits<float>::Max(), std::memory_order_relaxed);
+        LastSeen.store(TNumericLimits<float>::Lowest(), std::memory_order_relaxed);
+
+        for (int32 Index = 0; Index < NumBuckets; ++Index)
+        {
+            Buckets[Index].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64> Total{ 0 };
+    std::atomic<float> FirstSeen;
+    std::atomic<float> LastSeen;
+
+    /** Per slot: (bucket index << 32) | count. */
+    TUniquePtr<std::atomic<uint64>[]> Buckets;
+};
+
+struct FGameplayEventAggregator::FStateTable
+{
+    explicit FStateTable(int32 InNum)
+        : Num(InNum)
+        , Slots(MakeUnique<std::atomic<FNameState*>[]>(InNum))
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            Slots[Index].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    const int32 Num;
+    TUniquePtr<std::atomic<FNameState*>[]> Slots;
+};
+
+namespace GameplayEventAggregatorPrivate
+{
+    /** Slots in the first state table; later tables at least double. */
+    constexpr int32 MinTableSize = 256;
+
+    /** Stores Value into Target if Compare(Value, Target) holds, for concurrent min/max tracking. */
+    template <typename CompareType>
+    void UpdateExtreme(std::atomic<float>& Target, float Value, CompareType Compare)
+    {
+        float Current = Target.load(std::memory_order_relaxed);
+        while (Compare(Value, Current) && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+FGameplayEventAggregator::FGameplayEventAggregator(float InBucketSeconds, int32 InNumBuckets)
+    : BucketSeconds(FMath::Max(InBucketSeconds, 0.001f))
+    , NumBuckets(FMath::Max(InNumBuckets, 1))
+{
+}
+
+FGameplayEventAggregator::~FGameplayEventAggregator() = default;
+
+void FGameplayEventAggregator::Record(int32 NameId, float GameTime)
+{
+    using namespace GameplayEventAggregatorPrivate;
+
+    FNameState& State = FindOrAddState(NameId);
+    State.Total.fetch_add(1, std::memory_order_relaxed);
+    UpdateExtreme(State.FirstSeen, GameTime, [](float A, float B) { return A < B; });
+    UpdateExtreme(State.LastSeen, GameTime, [](float A, float B) { return A > B; });
+
+    const uint64 Bucket = GetBucketIndex(GameTime);
+    std::atomic<uint64>& Slot = State.Buckets[Bucket % NumBuckets];
+
+    uint64 Packed = Slot.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if ((Packed >> 32) > Bucket)
+        {
+            // A newer bucket already reused this slot; the event is too old to count
+            return;
+        }
+
+        const uint64 Count = (Packed >> 32) == Bucket ? (Packed & 0xFFFFFFFF) : 0;
+        if (Slot.compare_exchange_weak(Packed, (Bucket << 32) | FMath::Min<uint64>(Count + 1, 0xFFFFFFFF), std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+}
+
+bool FGameplayEventAggregator::Get(int32 NameId, float NowGameTime, FGameplayEventAggregate& OutAggregate) const
+{
+    const FNameState* State = FindState(NameId);
+    if (!State || State->Total.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+
+    OutAggregate.TotalCount = static_cast<int64>(State->Total.load(std::memory_order_relaxed));
+    OutAggregate.FirstSeenGameTime = State->FirstSeen.load(std::memory_order_relaxed);
+    OutAggregate.LastSeenGameTime = State->LastSeen.load(std::memory_order_relaxed);
+    OutAggregate.BucketSeconds = BucketSeconds;
+    OutAggregate.BucketCounts.SetNumZeroed(NumBuckets);
+
+    const uint32 NewestBucket = GetBucketIndex(NowGameTime);
+    const uint32 FirstSeenBucket = GetBucketIndex(OutAggregate.FirstSeenGameTime);
+    int64 WindowCount = 0;
+
+    for (int32 Offset = 0; Offset < NumBuckets; ++Offset)
+    {
+        const int64 Bucket = static_cast<int64>(NewestBucket) - (NumBuckets - 1) + Offset;
+        if (Bucket < 0)
+        {
+            continue;
+        }
+
+        const uint64 Packed = State->Buckets[Bucket % NumBuckets].load(std::memory_order_relaxed);
+        if ((Packed >> 32) == static_cast<uint64>(Bucket))
+        {
+            OutAggregate.BucketCounts[Offset] = static_cast<int32>(Packed & 0xFFFFFFFF);
+            WindowCount += OutAggregate.BucketCounts[Offset];
+        }
+    }
+
+    // Rate over the part of the window since the name was first seen
+    const int32 CoveredBuckets = FMath::Clamp(static_cast<int32>(NewestBucket) - static_cast<int32>(FirstSeenBucket) + 1, 1, NumBuckets);
+    OutAggregate.RatePerSecond = static_cast<float>(WindowCount / (CoveredBuckets * static_cast<double>(BucketSeconds)));
+    return true;
+}
+
+void FGameplayEventAggregator::ForEachName(TFunctionRef<void(int32 NameId)> Visitor) const
+{
+    const FStateTable* Current = Table.load(std::memory_order_acquire);
+
+    for (int32 NameId = 0; Current && NameId < Current->Num; ++NameId)
+    {
+        const FNameState* State = Current->Slots[NameId].load(std::memory_order_acquire);
+        if (State && State->Total.load(std::memory_order_relaxed) > 0)
+        {
+            Visitor(NameId);
+        }
+    }
+}
+
+void FGameplayEventAggregator::Reset()
+{
+    FScopeLock Lock(&WriteLock);
+
+    for (const TUniquePtr<FNameState>& State : States)
+    {
+        State->Reset(NumBuckets);
+    }
+}
+
+FGameplayEventAggregator::FNameState* FGameplayEventAggregator::FindState(int32 NameId) const
+{
+    const FStateTable* Current = Table.load(std::memory_order_acquire);
+    if (!Current || NameId < 0 || NameId >= Current->Num)
+    {
+        return nullptr;
+    }
+
+    return Current->Slots[NameId].load(std::memory_order_acquire);
+}
+
+FGameplayEventAggregator::FNameState& FGameplayEventAggregator::FindOrAddState(int32 NameId)
+{
+    check(NameId >= 0);
+
+    if (FNameState* State = FindState(NameId))
+    {
+        return *State;
+    }
+
+    FScopeLock Lock(&WriteLock);
+
+    FStateTable* Current = Table.load(std::memory_order_relaxed);
+    if (!Current || NameId >= Current->Num)
+    {
+        const int32 NewNum = FMath::Max(NameId + 1, Current ? Current->Num * 2 : GameplayEventAggregatorPrivate::MinTableSize);
+        TUniquePtr<FStateTable> Grown = MakeUnique<FStateTable>(NewNum);
+
+        for (int32 Index = 0; Current && Index < Current->Num; ++Index)
+        {
+            Grown->Slots[Index].store(Current->Slots[Index].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        Current = Grown.Get();
+        Tables.Add(MoveTemp(Grown));
+        Table.store(Current, std::memory_order_release);
+    }
+
+    // Another thread may have created it between the lookup and the lock
+    if (FNameState* Existing = Current->Slots[NameId].load(std::memory_order_relaxed))
+    {
+        return *Existing;
+    }
+
+    FNameState* State = States.Add_GetRef(MakeUnique<FNameState>(NumBuckets)).Get();
+    Current->Slots[NameId].store(State, std::memory_order_release);
+    return *State;
+}
+
+uint32 FGameplayEventAggregator::GetBucketIndex(float GameTime) const
+{
+    return static_cast<uint32>(FMath::Max(GameTime, 0.f) / BucketSeconds);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FGameplayEventAggregate;
+
+/**
+ * FGameplayEventAggregator
+ * ------------------------
+ * Rolling per-event-name counters kept next to (or instead of) the raw event log.
+ *
+ * Every name owns a ring of NumBuckets time buckets of BucketSeconds of game time each,
+ * plus a total and first/last seen times. Recording is lock-free once a name has been
+ * seen: name states are found through a table of atomic pointers indexed by name handle,
+ * and each bucket is one atomic word packing the bucket index with its count, so a stale
+ * slot is recycled by the first event of its new bucket. Only the first event of a name
+ * takes a lock, to create its state. Queries read NumBuckets words and never touch the
+ * event log.
+ *
+ * Per-name state lives until the aggregator is destroyed; Reset only zeroes it, so
+ * producers can keep using pointers obtained without a lock. Outgrown tables are kept
+ * for the same reason.
+ */
+class YOURPROJECT_API FGameplayEventAggregator
+{
+public:
+    FGameplayEventAggregator(float InBucketSeconds, int32 InNumBuckets);
+    ~FGameplayEventAggregator();
+
+    /** Counts one event named NameId at GameTime. Thread-safe, and lock-free once NameId has been recorded. */
+    void Record(int32 NameId, float GameTime);
+
+    /** Fills everything but EventName for NameId, with the newest bucket holding NowGameTime. Returns false if the name was never recorded. */
+    bool Get(int32 NameId, float NowGameTime, FGameplayEventAggregate& OutAggregate) const;
+
+    /** Calls Visitor with every name recorded at least once. */
+    void ForEachName(TFunctionRef<void(int32 NameId)> Visitor) const;
+
+    /** Zeroes every counter. Events recorded concurrently may survive the reset. */
+    void Reset();
+
+    float GetBucketSeconds() const { return BucketSeconds; }
+    int32 GetNumBuckets() const { return NumBuckets; }
+
+private:
+    struct FNameState;
+    struct FStateTable;
+
+    /** Returns the state of NameId, or null if it was never recorded. Lock-free. */
+    FNameState* FindState(int32 NameId) const;
+
+    /** Returns the state of NameId, creating it on first use. */
+    FNameState& FindOrAddState(int32 NameId);
+
+    uint32 GetBucketIndex(float GameTime) const;
+
+    float BucketSeconds;
+    int32 NumBuckets;
+
+    /** Serializes creating states, growing the table and Reset. Record and queries never take it. */
+    mutable FCriticalSection WriteLock;
+
+    /** Current state per name handle; a null slot is a name never recorded. */
+    std::atomic<FStateTable*> Table{ nullptr };
+
+    /** Every table and state ever published, owned here because readers may still hold outgrown tables. Guarded by WriteLock. */
+    TArray<TUniquePtr<FStateTable>> Tables;
+    TArray<TUniquePtr<FNameState>> States;
+};
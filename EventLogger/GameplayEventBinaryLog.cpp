@@ -0,0 +1,473 @@
+#include "GameplayEventBinaryLog.h"
+#include "GameplayEventCSVWriter.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventStringTable.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Algo/BinarySearch.h"
+
+// ---------------------------------------------------------------------------
+// FGameplayEventBinaryWriter
+// ---------------------------------------------------------------------------
+
+FGameplayEventBinaryWriter::FGameplayEventBinaryWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock, int32 InChunkRecords)
+    : Strings(InStrings)
+    , Clock(InClock)
+    , ChunkRecords(FMath::Max(InChunkRecords, 64))
+{
+}
+
+FGameplayEventBinaryWriter::~FGameplayEventBinaryWriter()
+{
+    if (Ar)
+    {
+        // Abandoned write: the header still says zero records, so readers see an empty log
+        Ar->Close();
+    }
+}
+
+bool FGameplayEventBinaryWriter::Open(const FString& FilePath)
+{
+    Ar.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Ar)
+    {
+        return false;
+    }
+
+    Header = FGameplayEventBinaryHeader();
+    Header.RecordSize = sizeof(FGameplayEventBinaryRecord);
+    Header.RecordsOffset = sizeof(FGameplayEventBinaryHeader);
+
+    // Placeholder, patched with the final counts in Close
+    Ar->Serialize(&Header, sizeof(Header));
+
+    Chunk.Reset(ChunkRecords);
+    NumSharedStrings = Strings.Num();
+    ContextStrings.Reset();
+    ContextIds.Reset();
+    return true;
+}
+
+void FGameplayEventBinaryWriter::Write(TArrayView<const FGameplayEventRecord> Records)
+{
+    check(Ar);
+
+    for (const FGameplayEventRecord& Record : Records)
+    {
+        FGameplayEventBinaryRecord& Out = Chunk.AddDefaulted_GetRef();
+        Out.UtcTicks = Clock.ToUtcTicks(Record.Cycles);
+        Out.GameTime = Record.GameTime;
+        Out.Sequence = Record.Sequence;
+        Out.NameId = Record.NameId;
+        Out.ContextId = GetContextId(Record.Context);
+        Out.OwnerId = Record.OwnerId;
+        Out.FrameNumber = Record.FrameNumber;
+
+        if (Chunk.Num() >= ChunkRecords)
+        {
+            FlushChunk();
+        }
+    }
+}
+
+bool FGameplayEventBinaryWriter::Close()
+{
+    if (!Ar)
+    {
+        return false;
+    }
+
+    FlushChunk();
+
+    Header.StringTableOffset = static_cast<uint64>(Ar->Tell());
+    Header.NumStrings = static_cast<uint32>(NumSharedStrings + ContextStrings.Num());
+
+    auto WriteString = [this](const FString& String)
+    {
+        const FTCHARToUTF8 Converted(*String);
+        uint32 ByteLength = static_cast<uint32>(Converted.Length());
+        Ar->Serialize(&ByteLength, sizeof(ByteLength));
+        Ar->Serialize(const_cast<ANSICHAR*>(Converted.Get()), ByteLength);
+    };
+
+    // Strings interned after Open are not referenced by the records, and would shift the context ids
+    for (int32 Id = 0; Id < NumSharedStrings; ++Id)
+    {
+        WriteString(Strings.Resolve(Id));
+    }
+
+    for (const FString& Context : ContextStrings)
+    {
+        WriteString(Context);
+    }
+
+    Ar->Seek(0);
+    Ar->Serialize(&Header, sizeof(Header));
+
+    const bool bSuccess = !Ar->IsError();
+    const bool bClosed = Ar->Close();
+    Ar.Reset();
+    return bClosed && bSuccess;
+}
+
+bool FGameplayEventBinaryWriter::WriteFile(const FString& FilePath, TArrayView<const FGameplayEventRecord> Records)
+{
+    if (!Open(FilePath))
+    {
+        return false;
+    }
+
+    Write(Records);
+    return Close();
+}
+
+int32 FGameplayEventBinaryWriter::GetContextId(const FString& Context)
+{
+    if (Context.IsEmpty())
+    {
+        return FGameplayEventStringTable::EmptyHandle;
+    }
+
+    if (const int32* Existing = ContextIds.Find(Context))
+    {
+        return *Existing;
+    }
+
+    const int32 Id = NumSharedStrings + ContextStrings.Add(Context);
+    ContextIds.Add(Context, Id);
+    return Id;
+}
+
+void FGameplayEventBinaryWriter::FlushChunk()
+{
+    if (Chunk.Num() > 0)
+    {
+        Ar->Serialize(Chunk.GetData(), Chunk.Num() * sizeof(FGameplayEventBinaryRecord));
+        Header.NumRecords += Chunk.Num();
+        Chunk.Reset();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FGameplayEventBinaryReader
+// ---------------------------------------------------------------------------
+
+FGameplayEventBinaryReader::FGameplayEventBinaryReader()
+{
+}
+
+FGameplayEventBinaryReader::~FGameplayEventBinaryReader()
+{
+    Close();
+}
+
+bool FGameplayEventBinaryReader::Open(const FString& FilePath)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+
+    if (MappedHandle)
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion());
+    }
+
+    if (MappedRegion)
+    {
+        return ParseContents(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), FilePath);
+    }
+
+    // Mapping unsupported on this platform or file system, read it instead
+    MappedHandle.Reset();
+    if (!FFileHelper::LoadFileToArray(FallbackContents, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to open binary log: %s"), *FilePath);
+        return false;
+    }
+
+    return ParseContents(FallbackContents.GetData(), FallbackContents.Num(), FilePath);
+}
+
+void FGameplayEventBinaryReader::Close()
+{
+    Records = TArrayView<const FGameplayEventBinaryRecord>();
+    Strings.Empty();
+
+    // Region must be released before its file handle
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+    FallbackContents.Empty();
+    UpgradedRecords.Empty();
+}
+
+const FString& FGameplayEventBinaryReader::ResolveString(int32 Id) const
+{
+    static const FString Empty;
+    return Strings.IsValidIndex(Id) ? Strings[Id] : Empty;
+}
+
+bool FGameplayEventBinaryReader::ParseContents(const uint8* Data, int64 Size, const FString& FilePath)
+{
+    FGameplayEventBinaryHeader Header;
+    if (!Data || Size < static_cast<int64>(sizeof(Header)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Binary log is truncated: %s"), *FilePath);
+        return false;
+    }
+
+    FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+    const bool bCurrentVersion = Header.Version == GameplayEventBinaryLog::Version && Header.RecordSize == sizeof(FGameplayEventBinaryRecord);
+    const bool bVersion1 = Header.Version == 1 && Header.RecordSize == sizeof(FGameplayEventBinaryRecordV1);
+
+    if (Header.Magic != GameplayEventBinaryLog::Magic || (!bCurrentVersion && !bVersion1))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Unsupported binary log (magic %08x, version %d): %s"),
+            Header.Magic, Header.Version, *FilePath);
+        return false;
+    }
+
+    const uint64 RecordsEnd = Header.RecordsOffset + Header.NumRecords * Header.RecordSize;
+    if (RecordsEnd > static_cast<uint64>(Size) || Header.StringTableOffset > static_cast<uint64>(Size)
+        || Header.RecordsOffset % alignof(FGameplayEventBinaryRecord) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Binary log sections are out of range: %s"), *FilePath);
+        return false;
+    }
+
+    if (bVersion1)
+    {
+        const TArrayView<const FGameplayEventBinaryRecordV1> OldRecords(
+            reinterpret_cast<const FGameplayEventBinaryRecordV1*>(Data + Header.RecordsOffset),
+            static_cast<int32>(Header.NumRecords));
+
+        UpgradedRecords.Reserve(OldRecords.Num());
+        for (const FGameplayEventBinaryRecordV1& In : OldRecords)
+        {
+            FGameplayEventBinaryRecord& Out = UpgradedRecords.AddDefaulted_GetRef();
+            Out.UtcTicks = In.UtcTicks;
+            Out.GameTime = In.GameTime;
+            Out.NameId = In.NameId;
+            Out.ContextId = In.ContextId;
+            Out.OwnerId = In.OwnerId;
+        }
+        Records = UpgradedRecords;
+    }
+    else
+    {
+        Records = TArrayView<const FGameplayEventBinaryRecord>(
+            reinterpret_cast<const FGameplayEventBinaryRecord*>(Data + Header.RecordsOffset),
+            static_cast<int32>(Header.NumRecords));
+    }
+
+    Strings.Reserve(Header.NumStrings);
+
+    uint64 Cursor = Header.StringTableOffset;
+    for (uint32 Index = 0; Index < Header.NumStrings; ++Index)
+    {
+        uint32 ByteLength = 0;
+        if (Cursor + sizeof(ByteLength) > static_cast<uint64>(Size))
+        {
+            break;
+        }
+
+        FMemory::Memcpy(&ByteLength, Data + Cursor, sizeof(ByteLength));
+        Cursor += sizeof(ByteLength);
+
+        if (Cursor + ByteLength > static_cast<uint64>(Size))
+        {
+            break;
+        }
+
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Cursor), ByteLength);
+        Strings.Emplace(Converted.Length(), Converted.Get());
+        Cursor += ByteLength;
+    }
+
+    if (Strings.Num() != static_cast<int32>(Header.NumStrings))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] Binary log string table is truncated (%d of %u strings): %s"),
+            Strings.Num(), Header.NumStrings, *FilePath);
+    }
+
+    return true;
+}
+
+bool FGameplayEventBinaryReader::ConvertToCSV(const FString& BinaryPath, const FString& CSVPath)
+{
+    FGameplayEventBinaryReader Reader;
+    if (!Reader.Open(BinaryPath))
+    {
+        return false;
+    }
+
+    // Rebuild a string table so the regular CSV writer can be reused; ids are remapped in case of duplicates
+    FGameplayEventStringTable StringTable;
+    TArray<int32> IdRemap;
+    IdRemap.Reserve(Reader.GetStrings().Num());
+    for (const FString& String : Reader.GetStrings())
+    {
+        IdRemap.Add(StringTable.Intern(String));
+    }
+
+    auto Remap = [&IdRemap](int32 Id)
+    {
+        return IdRemap.IsValidIndex(Id) ? IdRemap[Id] : FGameplayEventStringTable::EmptyHandle;
+    };
+
+    // The file already stores UTC ticks; carry them through as identity-clock cycles
+    FGameplayEventCSVWriter Writer(StringTable, FGameplayEventClock::Identity());
+    if (!Writer.Open(CSVPath))
+    {
+        return false;
+    }
+
+    constexpr int32 BatchSize = 16 * 1024;
+    TArray<FGameplayEventRecord> Batch;
+    Batch.Reserve(BatchSize);
+
+    for (const FGameplayEventBinaryRecord& In : Reader.GetRecords())
+    {
+        FGameplayEventRecord& Out = Batch.AddDefaulted_GetRef();
+        Out.Cycles = static_cast<uint64>(In.UtcTicks);
+        Out.Sequence = In.Sequence;
+        Out.GameTime = In.GameTime;
+        Out.NameId = Remap(In.NameId);
+        Out.Context = Reader.ResolveString(In.ContextId);
+        Out.OwnerId = Remap(In.OwnerId);
+        Out.FrameNumber = In.FrameNumber;
+
+        if (Batch.Num() == BatchSize)
+        {
+            Writer.Write(Batch);
+            Batch.Reset();
+        }
+    }
+
+    Writer.Write(Batch);
+    return Writer.Close();
+}
+
+bool FGameplayEventBinaryReader::FindFirstDivergence(const FString& PathA, const FString& PathB, double GameTimeTolerance, FGameplayEventLogDivergence& OutDivergence)
+{
+    FGameplayEventBinaryReader ReaderA;
+    FGameplayEventBinaryReader ReaderB;
+    if (!ReaderA.Open(PathA) || !ReaderB.Open(PathB))
+    {
+        return false;
+    }
+
+    // Two runs intern strings in different orders, so translate B's ids into A's once up front.
+    // Matched case-sensitively, as interned, so "hit" in B is not taken for "Hit" in A.
+    TMap<FString, int32, FDefaultSetAllocator, FGameplayEventStringTable::FCaseSensitiveKeyFuncs> IdsInA;
+    IdsInA.Reserve(ReaderA.GetStrings().Num());
+    for (int32 Id = 0; Id < ReaderA.GetStrings().Num(); ++Id)
+    {
+        IdsInA.FindOrAdd(ReaderA.GetStrings()[Id], Id);
+    }
+
+    TArray<int32> BToA;
+    BToA.Reserve(ReaderB.GetStrings().Num());
+    for (const FString& String : ReaderB.GetStrings())
+    {
+        const int32* IdInA = IdsInA.Find(String);
+        BToA.Add(IdInA ? *IdInA : INDEX_NONE);
+    }
+
+    auto RemapB = [&BToA](int32 Id)
+    {
+        return BToA.IsValidIndex(Id) ? BToA[Id] : INDEX_NONE;
+    };
+
+    const TArrayView<const FGameplayEventBinaryRecord> RecordsA = ReaderA.GetRecords();
+    const TArrayView<const FGameplayEventBinaryRecord> RecordsB = ReaderB.GetRecords();
+
+    // Replay captures are written in sequence order, so the common start is a binary search away
+    const bool bSequenced = RecordsA.Num() > 0 && RecordsB.Num() > 0 && RecordsA[0].Sequence != 0 && RecordsB[0].Sequence != 0;
+
+    int32 FirstA = 0;
+    int32 FirstB = 0;
+    if (bSequenced)
+    {
+        const uint64 StartSequence = FMath::Max(RecordsA[0].Sequence, RecordsB[0].Sequence);
+        FirstA = Algo::LowerBoundBy(RecordsA, StartSequence, &FGameplayEventBinaryRecord::Sequence);
+        FirstB = Algo::LowerBoundBy(RecordsB, StartSequence, &FGameplayEventBinaryRecord::Sequence);
+    }
+
+    // Runs rarely start on the same engine frame, so frames are compared relative to the start
+    const uint32 BaseFrameA = RecordsA.IsValidIndex(FirstA) ? RecordsA[FirstA].FrameNumber : 0;
+    const uint32 BaseFrameB = RecordsB.IsValidIndex(FirstB) ? RecordsB[FirstB].FrameNumber : 0;
+
+    auto Describe = [](const FGameplayEventBinaryReader& Reader, const FGameplayEventBinaryRecord& Record)
+    {
+        return FString::Printf(TEXT("Seq: %llu | Frame: %u | GameTime: %.9f | Owner: %s | Event: %s | Context: %s"),
+            Record.Sequence, Record.FrameNumber, Record.GameTime, *Reader.ResolveString(Record.OwnerId),
+            *Reader.ResolveString(Record.NameId), *Reader.ResolveString(Record.ContextId));
+    };
+
+    const int32 NumA = RecordsA.Num() - FirstA;
+    const int32 NumB = RecordsB.Num() - FirstB;
+    const int32 NumCommon = FMath::Min(NumA, NumB);
+
+    for (int32 Offset = 0; Offset < NumCommon; ++Offset)
+    {
+        const FGameplayEventBinaryRecord& A = RecordsA[FirstA + Offset];
+        const FGameplayEventBinaryRecord& B = RecordsB[FirstB + Offset];
+
+        const TCHAR* Reason = nullptr;
+        if (A.Sequence != B.Sequence)
+        {
+            Reason = TEXT("sequence");
+        }
+        else if (A.FrameNumber - BaseFrameA != B.FrameNumber - BaseFrameB)
+        {
+            Reason = TEXT("frame");
+        }
+        else if (FMath::Abs(A.GameTime - B.GameTime) > GameTimeTolerance)
+        {
+            Reason = TEXT("game time");
+        }
+        else if (A.NameId != RemapB(B.NameId))
+        {
+            Reason = TEXT("name");
+        }
+        else if (A.ContextId != RemapB(B.ContextId))
+        {
+            Reason = TEXT("context");
+        }
+        else if (A.OwnerId != RemapB(B.OwnerId))
+        {
+            Reason = TEXT("owner");
+        }
+
+        if (Reason)
+        {
+            OutDivergence.bDiverged = true;
+            OutDivergence.IndexA = FirstA + Offset;
+            OutDivergence.IndexB = FirstB + Offset;
+            OutDivergence.NumMatched = Offset;
+            OutDivergence.Reason = Reason;
+            OutDivergence.EventA = Describe(ReaderA, A);
+            OutDivergence.EventB = Describe(ReaderB, B);
+            return true;
+        }
+    }
+
+    OutDivergence.NumMatched = NumCommon;
+    OutDivergence.IndexA = FirstA + NumCommon;
+    OutDivergence.IndexB = FirstB + NumCommon;
+
+    if (NumA != NumB)
+    {
+        // One run logged more events after everything else matched
+        OutDivergence.bDiverged = true;
+        OutDivergence.Reason = TEXT("length");
+        OutDivergence.EventA = NumA > NumCommon ? Describe(ReaderA, RecordsA[FirstA + NumCommon]) : FString();
+        OutDivergence.EventB = NumB > NumCommon ? Describe(ReaderB, RecordsB[FirstB + NumCommon]) : FString();
+    }
+
+    return true;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventStringTable.h"
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FGameplayEventLogDivergence;
+struct FGameplayEventRecord;
+
+/**
+ * Binary event log format (.gelog)
+ * --------------------------------
+ * [FGameplayEventBinaryHeader]
+ * [NumRecords x FGameplayEventBinaryRecord]   fixed width, starts at RecordsOffset
+ * [NumStrings x (uint32 ByteLength, UTF-8 bytes)]   starts at StringTableOffset
+ *
+ * Name, context and owner ids in the records index the string table; id 0 is the empty string.
+ * The writer stores the logger's interned strings first and the distinct contexts after them.
+ * All values are little-endian. The string table is written last so records can be
+ * streamed before every string is known.
+ *
+ * Version 2 widened game time to double and added the sequence and frame numbers of replay
+ * capture. Version 1 files are still read, with both numbers 0.
+ */
+namespace GameplayEventBinaryLog
+{
+    /** 'GELB' */
+    constexpr uint32 Magic = 0x424C4547;
+
+    constexpr uint16 Version = 2;
+}
+
+struct FGameplayEventBinaryHeader
+{
+    uint32 Magic = GameplayEventBinaryLog::Magic;
+    uint16 Version = GameplayEventBinaryLog::Version;
+    uint16 HeaderSize = sizeof(FGameplayEventBinaryHeader);
+    uint32 RecordSize = 0;
+    uint32 NumStrings = 0;
+    uint64 NumRecords = 0;
+    uint64 RecordsOffset = 0;
+    uint64 StringTableOffset = 0;
+};
+
+/** On-disk record, kept separate from FGameplayEventRecord so the in-memory layout can change freely. */
+struct FGameplayEventBinaryRecord
+{
+    int64 UtcTicks = 0;
+    double GameTime = 0.0;
+
+    /** Replay capture sequence number; 0 when the log was not captured in replay mode. */
+    uint64 Sequence = 0;
+
+    int32 NameId = 0;
+    int32 ContextId = 0;
+
+    /** String id of the logging actor. */
+    int32 OwnerId = 0;
+
+    /** Low 32 bits of the engine frame counter when the event was logged. */
+    uint32 FrameNumber = 0;
+};
+
+/** Record layout of version 1 files. */
+struct FGameplayEventBinaryRecordV1
+{
+    int64 UtcTicks = 0;
+    float GameTime = 0.f;
+    int32 NameId = 0;
+    int32 ContextId = 0;
+    int32 OwnerId = 0;
+};
+
+static_assert(sizeof(FGameplayEventBinaryHeader) == 40, "Binary event log header layout changed, bump the version.");
+static_assert(sizeof(FGameplayEventBinaryRecord) == 40, "Binary event log record layout changed, bump the version.");
+static_assert(sizeof(FGameplayEventBinaryRecordV1) == 24, "Version 1 record layout is frozen.");
+
+/**
+ * FGameplayEventBinaryWriter
+ * --------------------------
+ * Streams records to a .gelog file in fixed-size chunks. The header is rewritten with
+ * the final counts on Close, together with the string table.
+ *
+ * Records carry their context as text, so each distinct context gets a file string id the
+ * first time it is written; names and owners keep their handles in the logger's table.
+ */
+class YOURPROJECT_API FGameplayEventBinaryWriter
+{
+public:
+    /** Default number of records buffered before each write to disk. */
+    static constexpr int32 DefaultChunkRecords = 16 * 1024;
+
+    /**
+     * Records are stored with absolute UTC ticks, converted from their cycle counts with InClock.
+     * InStrings must hold every name and owner of the records written and outlive the writer.
+     */
+    FGameplayEventBinaryWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock, int32 InChunkRecords = DefaultChunkRecords);
+    ~FGameplayEventBinaryWriter();
+
+    /** Creates FilePath and reserves space for the header. Records written afterwards may only use handles interned before. Returns false if the file could not be opened. */
+    bool Open(const FString& FilePath);
+
+    /** Appends records, flushing whenever the chunk buffer is full. Requires Open. */
+    void Write(TArrayView<const FGameplayEventRecord> Records);
+
+    /** Flushes records, writes the string table, patches the header and closes. Returns success. */
+    bool Close();
+
+    /** Writes every record and the string table to FilePath in one call. Returns success. */
+    bool WriteFile(const FString& FilePath, TArrayView<const FGameplayEventRecord> Records);
+
+private:
+    void FlushChunk();
+
+    /** File string id of a context, assigning the next free one on first use. */
+    int32 GetContextId(const FString& Context);
+
+    const FGameplayEventStringTable& Strings;
+
+    /** Handles of Strings written to the file; contexts are numbered after them. Fixed by Open. */
+    int32 NumSharedStrings = 0;
+
+    /** Distinct contexts in file id order, and their ids. */
+    TArray<FString> ContextStrings;
+    TMap<FString, int32, FDefaultSetAllocator, FGameplayEventStringTable::FCaseSensitiveKeyFuncs> ContextIds;
+
+    FGameplayEventClock Clock;
+    int32 ChunkRecords;
+    TArray<FGameplayEventBinaryRecord> Chunk;
+    TUniquePtr<FArchive> Ar;
+    FGameplayEventBinaryHeader Header;
+};
+
+/**
+ * FGameplayEventBinaryReader
+ * --------------------------
+ * Loads a .gelog file. The file is memory-mapped when the platform supports it, so
+ * GetRecords() is a zero-copy view into the mapping; otherwise the file is read into memory.
+ * Only the string table is decoded up front. Version 1 records are upgraded into a copy.
+ */
+class YOURPROJECT_API FGameplayEventBinaryReader
+{
+public:
+    FGameplayEventBinaryReader();
+    ~FGameplayEventBinaryReader();
+
+    /** Opens and validates FilePath. Returns false (and logs why) on a missing or malformed file. */
+    bool Open(const FString& FilePath);
+
+    /** Releases the mapping and decoded strings. */
+    void Close();
+
+    /** Records in file order. Valid until Close or destruction. */
+    TArrayView<const FGameplayEventBinaryRecord> GetRecords() const { return Records; }
+
+    /** Decoded string table, indexed by record name/context id. */
+    const TArray<FString>& GetStrings() const { return Strings; }
+
+    /** Resolves an id to its string; out-of-range ids resolve to the empty string. */
+    const FString& ResolveString(int32 Id) const;
+
+    /** Converts a .gelog file to the same CSV layout as UGameplayEventLogger::ExportLogToCSV. Returns success. */
+    static bool ConvertToCSV(const FString& BinaryPath, const FString& CSVPath);
+
+    /**
+     * Compares two .gelog files event by event and fills OutDivergence with the first difference.
+     * When both logs carry sequence numbers they are aligned on the first sequence present in
+     * both, so a log whose oldest events were evicted still lines up; otherwise both start at
+     * their first record. String ids are compared through a remap of B's table onto A's, so the
+     * pass itself only compares integers. Returns false if either file cannot be read.
+     */
+    static bool FindFirstDivergence(const FString& PathA, const FString& PathB, double GameTimeTolerance, FGameplayEventLogDivergence& OutDivergence);
+
+private:
+    bool ParseContents(const uint8* Data, int64 Size, const FString& FilePath);
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** Used when memory mapping is unavailable. */
+    TArray<uint8> FallbackContents;
+
+    /** Version 1 records converted to the current layout. */
+    TArray<FGameplayEventBinaryRecord> UpgradedRecords;
+
+    TArrayView<const FGameplayEventBinaryRecord> Records;
+    TArray<FString> Strings;
+};
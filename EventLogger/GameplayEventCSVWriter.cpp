@@ -0,0 +1,172 @@
+#include "GameplayEventCSVWriter.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventStringTable.h"
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+const TCHAR* FGameplayEventCSVWriter::Header = TEXT("GameTime,EventName,Context,UTC_Timestamp,Owner,Fields\n");
+
+FGameplayEventCSVWriter::FGameplayEventCSVWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock, const FGameplayEventFieldSnapshot* InFields, int32 InChunkChars)
+    : Strings(InStrings)
+    , Clock(InClock)
+    , Fields(InFields)
+    , ChunkChars(FMath::Max(InChunkChars, 1024))
+{
+}
+
+FGameplayEventCSVWriter::~FGameplayEventCSVWriter()
+{
+    if (Ar)
+    {
+        Close();
+    }
+}
+
+void FGameplayEventCSVWriter::AppendRow(const FGameplayEventRecord& Record, FString& Out)
+{
+    AppendLeadingColumns(Record, Out);
+
+    if (Fields)
+    {
+        AppendFieldsColumn(*Fields, static_cast<int32>(Record.FirstFieldId - Fields->GetFirstId()), Record.NumFields, Out);
+    }
+
+    Out += TEXT('\n');
+}
+
+void FGameplayEventCSVWriter::AppendRow(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> RecordFields, FString& Out)
+{
+    AppendLeadingColumns(Record, Out);
+    AppendFieldsColumn(RecordFields, 0, RecordFields.Num(), Out);
+    Out += TEXT('\n');
+}
+
+void FGameplayEventCSVWriter::AppendLeadingColumns(const FGameplayEventRecord& Record, FString& Out)
+{
+    Out.Appendf(TEXT("%.3f,"), Record.GameTime);
+    Out += GetSanitized(Record.NameId);
+    Out += TEXT(',');
+    AppendSanitized(Record.Context, Out);
+    Out += TEXT(',');
+    Out += Clock.ToUtc(Record.Cycles).ToString();
+    Out += TEXT(',');
+    Out += GetSanitized(Record.OwnerId);
+    Out += TEXT(',');
+}
+
+bool FGameplayEventCSVWriter::Open(const FString& FilePath)
+{
+    Ar.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Ar)
+    {
+        return false;
+    }
+
+    Chunk.Reset(ChunkChars + 512);
+    Chunk += Header;
+    return true;
+}
+
+void FGameplayEventCSVWriter::Write(TArrayView<const FGameplayEventRecord> Records)
+{
+    check(Ar);
+
+    for (const FGameplayEventRecord& Record : Records)
+    {
+        AppendRow(Record, Chunk);
+
+        if (Chunk.Len() >= ChunkChars)
+        {
+            FlushChunk();
+        }
+    }
+}
+
+bool FGameplayEventCSVWriter::Close()
+{
+    if (!Ar)
+    {
+        return false;
+    }
+
+    FlushChunk();
+
+    const bool bSuccess = !Ar->IsError();
+    const bool bClosed = Ar->Close();
+    Ar.Reset();
+    return bClosed && bSuccess;
+}
+
+bool FGameplayEventCSVWriter::WriteFile(const FString& FilePath, TArrayView<const FGameplayEventRecord> Records)
+{
+    if (!Open(FilePath))
+    {
+        return false;
+    }
+
+    Write(Records);
+    return Close();
+}
+
+void FGameplayEventCSVWriter::FlushChunk()
+{
+    if (Chunk.Len() > 0)
+    {
+        const FTCHARToUTF8 Converted(*Chunk);
+        Ar->Serialize(const_cast<ANSICHAR*>(Converted.Get()), Converted.Length());
+        Chunk.Reset(ChunkChars + 512);
+    }
+}
+
+FString FGameplayEventCSVWriter::Sanitize(const FString& Input)
+{
+    FString Output;
+    AppendSanitized(Input, Output);
+    return Output;
+}
+
+void FGameplayEventCSVWriter::AppendSanitized(const FString& Input, FString& Out)
+{
+    int32 Unused = INDEX_NONE;
+    if (!Input.FindChar(TEXT('"'), Unused) && !Input.FindChar(TEXT(','), Unused))
+    {
+        Out += Input;
+        return;
+    }
+
+    // Escape double quotes by doubling them, and wrap in quotes if contains commas or quotes
+    Out.Reserve(Out.Len() + Input.Len() + 2);
+    Out.AppendChar(TEXT('"'));
+    for (const TCHAR Char : Input)
+    {
+        if (Char == TEXT('"'))
+        {
+            Out.AppendChar(TEXT('"'));
+        }
+        Out.AppendChar(Char);
+    }
+    Out.AppendChar(TEXT('"'));
+}
+
+const FString& FGameplayEventCSVWriter::GetSanitized(int32 Handle)
+{
+    if (Handle < 0)
+    {
+        Handle = FGameplayEventStringTable::EmptyHandle;
+    }
+
+    if (Handle >= SanitizedCache.Num())
+    {
+        const int32 NewNum = FMath::Max(Handle + 1, Strings.Num());
+        SanitizedCache.SetNum(NewNum);
+        SanitizedValid.Add(false, NewNum - SanitizedValid.Num());
+    }
+
+    if (!SanitizedValid[Handle])
+    {
+        SanitizedCache[Handle] = Sanitize(Strings.Resolve(Handle));
+        SanitizedValid[Handle] = true;
+    }
+
+    return SanitizedCache[Handle];
+}
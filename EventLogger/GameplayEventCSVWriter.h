@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventFields.h"
+
+class FArchive;
+class FGameplayEventStringTable;
+struct FGameplayEventRecord;
+
+/**
+ * FGameplayEventCSVWriter
+ * -----------------------
+ * Formats event records as CSV rows and streams them to disk in fixed-size chunks,
+ * so exporting never builds the whole file in memory.
+ *
+ * Sanitized names and owners are cached per string handle, so repeated names are
+ * escaped once per export; contexts are escaped straight into the row. Typed fields are rendered into the last column when a field
+ * snapshot is supplied. Not thread-safe; create one writer per export.
+ */
+class YOURPROJECT_API FGameplayEventCSVWriter
+{
+public:
+    /** Column header line, including the trailing newline. */
+    static const TCHAR* Header;
+
+    /** Default number of characters buffered before each write to disk. */
+    static constexpr int32 DefaultChunkChars = 256 * 1024;
+
+    /** InFields must outlive the writer and hold the fields of every record written; null writes an empty Fields column. */
+    FGameplayEventCSVWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock, const FGameplayEventFieldSnapshot* InFields = nullptr, int32 InChunkChars = DefaultChunkChars);
+    ~FGameplayEventCSVWriter();
+
+    /** Appends one CSV row (with trailing newline) to Out, taking the record's fields from the snapshot. */
+    void AppendRow(const FGameplayEventRecord& Record, FString& Out);
+
+    /** Appends one CSV row for a record whose fields are not in storage yet. */
+    void AppendRow(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> RecordFields, FString& Out);
+
+    /** Creates FilePath and writes the header. Returns false if the file could not be opened. */
+    bool Open(const FString& FilePath);
+
+    /** Appends rows for Records, flushing to disk whenever the chunk buffer is full. Requires Open. */
+    void Write(TArrayView<const FGameplayEventRecord> Records);
+
+    /** Flushes the remaining chunk and closes the file. Returns true if every write succeeded. */
+    bool Close();
+
+    /** Writes the header and all records to FilePath in one call. Returns success. */
+    bool WriteFile(const FString& FilePath, TArrayView<const FGameplayEventRecord> Records);
+
+    /** Escapes double quotes and wraps the value in quotes if it contains commas or quotes. */
+    static FString Sanitize(const FString& Input);
+
+    /** Appends Input to Out, sanitized, without a temporary string. */
+    static void AppendSanitized(const FString& Input, FString& Out);
+
+private:
+    /** Appends every column before Fields, including the separating comma. */
+    void AppendLeadingColumns(const FGameplayEventRecord& Record, FString& Out);
+
+    /** Appends the rendered, sanitized fields as the last column. */
+    template <typename FieldSourceType>
+    void AppendFieldsColumn(const FieldSourceType& Source, int32 FirstIndex, int32 Num, FString& Out)
+    {
+        if (Num > 0)
+        {
+            FieldText.Reset();
+            FGameplayEventField::AppendAll(Source, FirstIndex, Num, FieldText);
+            Out += Sanitize(FieldText);
+        }
+    }
+
+    /** Returns the sanitized string for a handle, computing it on first use. */
+    const FString& GetSanitized(int32 Handle);
+
+    /** Converts the chunk to UTF-8, writes it and clears it. */
+    void FlushChunk();
+
+    const FGameplayEventStringTable& Strings;
+    FGameplayEventClock Clock;
+    const FGameplayEventFieldSnapshot* Fields;
+
+    /** Characters buffered before each write to disk. */
+    int32 ChunkChars;
+
+    /** Pending text; Reset keeps its allocation between chunks. */
+    FString Chunk;
+
+    /** Scratch buffer for rendering one record's fields before they are sanitized. */
+    FString FieldText;
+
+    /** Open file while streaming. */
+    TUniquePtr<FArchive> Ar;
+
+    /** Sanitized strings indexed by handle; unset entries are marked in SanitizedValid. */
+    TArray<FString> SanitizedCache;
+    TBitArray<> SanitizedValid;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * FGameplayEventClock
+ * -------------------
+ * Maps raw high-resolution cycle counts to UTC.
+ *
+ * Records only store FPlatformTime::Cycles64() when they are logged, which is a single
+ * counter read. The logger captures one wall-clock anchor per session; UTC is rebuilt
+ * from it only when an event is exported, displayed or queried by date.
+ *
+ * Reconstructed times drift from the system clock if it is adjusted during the session,
+ * which is the price of not reading it per event.
+ */
+struct FGameplayEventClock
+{
+    /** UTC time of the anchor, in FDateTime ticks. */
+    int64 AnchorUtcTicks = 0;
+
+    /** Cycle count read together with AnchorUtcTicks. */
+    uint64 AnchorCycles = 0;
+
+    /** FDateTime ticks per cycle. 1 means cycles already are UTC ticks (see Identity). */
+    double UtcTicksPerCycle = 1.0;
+
+    /** Anchors a clock to the current wall-clock time. */
+    static FGameplayEventClock CaptureNow()
+    {
+        FGameplayEventClock Clock;
+        Clock.AnchorCycles = FPlatformTime::Cycles64();
+        Clock.AnchorUtcTicks = FDateTime::UtcNow().GetTicks();
+        Clock.UtcTicksPerCycle = FPlatformTime::GetSecondsPerCycle64() * ETimespan::TicksPerSecond;
+        return Clock;
+    }
+
+    /** Clock whose "cycles" are UTC ticks, for records rebuilt from files that store UTC directly. */
+    static FGameplayEventClock Identity()
+    {
+        return FGameplayEventClock();
+    }
+
+    /** Timestamp to store in a new record. */
+    static FORCEINLINE uint64 ReadCycles()
+    {
+        return FPlatformTime::Cycles64();
+    }
+
+    int64 ToUtcTicks(uint64 Cycles) const
+    {
+        const int64 Delta = static_cast<int64>(Cycles - AnchorCycles);
+
+        // Exact integer path for identity clocks; real anchors keep deltas small enough for doubles
+        if (UtcTicksPerCycle == 1.0)
+        {
+            return AnchorUtcTicks + Delta;
+        }
+        return AnchorUtcTicks + static_cast<int64>(static_cast<double>(Delta) * UtcTicksPerCycle);
+    }
+
+    FDateTime ToUtc(uint64 Cycles) const
+    {
+        return FDateTime(ToUtcTicks(Cycles));
+    }
+
+    /** Inverse of ToUtcTicks, used to turn UTC query bounds into cycle bounds. Clamps to the uint64 range. */
+    uint64 FromUtcTicks(int64 UtcTicks) const
+    {
+        const int64 Delta = UtcTicks - AnchorUtcTicks;
+
+        if (UtcTicksPerCycle == 1.0)
+        {
+            return AnchorCycles + static_cast<uint64>(FMath::Max<int64>(Delta, 0));
+        }
+
+        const double Cycles = static_cast<double>(AnchorCycles) + static_cast<double>(Delta) / UtcTicksPerCycle;
+        if (Cycles <= 0.0)
+        {
+            return 0;
+        }
+        if (Cycles >= static_cast<double>(MAX_uint64))
+        {
+            return MAX_uint64;
+        }
+        return static_cast<uint64>(Cycles);
+    }
+};
@@ -0,0 +1,443 @@
+#include "GameplayEventCompressedLog.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventStringTable.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Serialization/Archive.h"
+
+FName GameplayEventCompressedLog::GetFormatName(EGameplayEventCompression Compression)
+{
+    switch (Compression)
+    {
+    case EGameplayEventCompression::Zlib:
+        return NAME_Zlib;
+    case EGameplayEventCompression::Oodle:
+        return NAME_Oodle;
+    case EGameplayEventCompression::LZ4:
+        return NAME_LZ4;
+    default:
+        return NAME_None;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FGameplayEventCompressedLogWriter
+// ---------------------------------------------------------------------------
+
+FGameplayEventCompressedLogWriter::FGameplayEventCompressedLogWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock,
+    EGameplayEventCompression InCompression, const FGameplayEventFieldSnapshot* InFields, int32 InBlockBytes)
+    : Rows(InStrings, InClock, InFields)
+    , Clock(InClock)
+    , Compression(InCompression)
+    , BlockBytes(FMath::Max(InBlockBytes, 4 * 1024))
+{
+}
+
+FGameplayEventCompressedLogWriter::~FGameplayEventCompressedLogWriter()
+{
+    if (Ar)
+    {
+        Close();
+    }
+}
+
+bool FGameplayEventCompressedLogWriter::Open(const FString& FilePath)
+{
+    Ar.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Ar)
+    {
+        return false;
+    }
+
+    FGameplayEventCompressedFileHeader FileHeader;
+    Ar->Serialize(&FileHeader, sizeof(FileHeader));
+
+    PendingRows.Reset(BlockBytes + 1024);
+    PendingBlock = FGameplayEventCompressedBlockHeader();
+    Index.Reset();
+    return true;
+}
+
+void FGameplayEventCompressedLogWriter::Write(TArrayView<const FGameplayEventRecord> Records)
+{
+    check(Ar);
+
+    for (const FGameplayEventRecord& Record : Records)
+    {
+        Rows.AppendRow(Record, PendingRows);
+        AddToPendingBlock(Record);
+    }
+}
+
+void FGameplayEventCompressedLogWriter::Write(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> RecordFields)
+{
+    check(Ar);
+
+    Rows.AppendRow(Record, RecordFields, PendingRows);
+    AddToPendingBlock(Record);
+}
+
+void FGameplayEventCompressedLogWriter::AddToPendingBlock(const FGameplayEventRecord& Record)
+{
+    const int64 UtcTicks = Clock.ToUtcTicks(Record.Cycles);
+
+    // The block index keeps float bounds; they only select blocks, rows are filtered by their own column
+    const float GameTime = static_cast<float>(Record.GameTime);
+
+    if (PendingBlock.NumRecords == 0)
+    {
+        PendingBlock.MinGameTime = PendingBlock.MaxGameTime = GameTime;
+        PendingBlock.MinUtcTicks = PendingBlock.MaxUtcTicks = UtcTicks;
+    }
+    else
+    {
+        // Ranges rather than first/last: merged thread buffers can deliver slightly out of order
+        PendingBlock.MinGameTime = FMath::Min(PendingBlock.MinGameTime, GameTime);
+        PendingBlock.MaxGameTime = FMath::Max(PendingBlock.MaxGameTime, GameTime);
+        PendingBlock.MinUtcTicks = FMath::Min(PendingBlock.MinUtcTicks, UtcTicks);
+        PendingBlock.MaxUtcTicks = FMath::Max(PendingBlock.MaxUtcTicks, UtcTicks);
+    }
+
+    ++PendingBlock.NumRecords;
+
+    if (PendingRows.Len() >= BlockBytes)
+    {
+        SealBlock();
+    }
+}
+
+bool FGameplayEventCompressedLogWriter::SealBlock()
+{
+    if (!Ar || PendingBlock.NumRecords == 0)
+    {
+        return Ar.IsValid();
+    }
+
+    const FTCHARToUTF8 Converted(*PendingRows);
+    const int32 RawSize = Converted.Length();
+    const uint8* Payload = reinterpret_cast<const uint8*>(Converted.Get());
+
+    PendingBlock.Compression = static_cast<uint8>(EGameplayEventCompression::None);
+    PendingBlock.UncompressedSize = static_cast<uint32>(RawSize);
+    PendingBlock.CompressedSize = static_cast<uint32>(RawSize);
+
+    const FName FormatName = GameplayEventCompressedLog::GetFormatName(Compression);
+    if (!FormatName.IsNone())
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, RawSize);
+        CompressedScratch.SetNumUninitialized(CompressedSize);
+
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        const bool bCompressed = FCompression::CompressMemory(FormatName, CompressedScratch.GetData(), CompressedSize, Payload, RawSize);
+        CompressCycles += FPlatformTime::Cycles64() - StartCycles;
+
+        // Incompressible rows or an unavailable codec: store the block raw so it stays readable
+        if (bCompressed && CompressedSize < RawSize)
+        {
+            PendingBlock.Compression = static_cast<uint8>(Compression);
+            PendingBlock.CompressedSize = static_cast<uint32>(CompressedSize);
+            Payload = CompressedScratch.GetData();
+        }
+    }
+
+    FGameplayEventCompressedIndexEntry Entry;
+    Entry.Offset = static_cast<uint64>(Ar->Tell());
+    Entry.Block = PendingBlock;
+
+    Ar->Serialize(&Entry.Block, sizeof(Entry.Block));
+    Ar->Serialize(const_cast<uint8*>(Payload), Entry.Block.CompressedSize);
+
+    // Hand the block to the OS now, so it survives the process dying before the next one
+    Ar->Flush();
+
+    const bool bWritten = !Ar->IsError();
+    if (bWritten)
+    {
+        Index.Add(Entry);
+        NumRecordsWritten += Entry.Block.NumRecords;
+        UncompressedBytes += RawSize;
+        CompressedBytes += sizeof(Entry.Block) + Entry.Block.CompressedSize;
+    }
+    else
+    {
+        NumRecordsLost += Entry.Block.NumRecords;
+    }
+
+    PendingRows.Reset();
+    PendingBlock = FGameplayEventCompressedBlockHeader();
+    return bWritten;
+}
+
+bool FGameplayEventCompressedLogWriter::Close()
+{
+    if (!Ar)
+    {
+        return false;
+    }
+
+    SealBlock();
+
+    FGameplayEventCompressedFooter Footer;
+    Footer.IndexOffset = static_cast<uint64>(Ar->Tell());
+    Footer.NumBlocks = static_cast<uint32>(Index.Num());
+
+    Ar->Serialize(Index.GetData(), Index.Num() * sizeof(FGameplayEventCompressedIndexEntry));
+    Ar->Serialize(&Footer, sizeof(Footer));
+
+    const bool bSuccess = !Ar->IsError() && NumRecordsLost == 0;
+    const bool bClosed = Ar->Close();
+    Ar.Reset();
+    return bClosed && bSuccess;
+}
+
+void FGameplayEventCompressedLogWriter::GetStats(FGameplayEventCompressionStats& OutStats) const
+{
+    OutStats.NumBlocks = Index.Num();
+    OutStats.UncompressedBytes = static_cast<int64>(UncompressedBytes);
+    OutStats.CompressedBytes = static_cast<int64>(CompressedBytes);
+    OutStats.CompressionRatio = CompressedBytes > 0 ? static_cast<float>(static_cast<double>(UncompressedBytes) / CompressedBytes) : 0.f;
+
+    const double UncompressedMB = UncompressedBytes / (1024.0 * 1024.0);
+    OutStats.CompressMillisecondsPerMB = UncompressedMB > 0.0 ? static_cast<float>(FPlatformTime::ToMilliseconds64(CompressCycles) / UncompressedMB) : 0.f;
+}
+
+// ---------------------------------------------------------------------------
+// FGameplayEventCompressedLogReader
+// ---------------------------------------------------------------------------
+
+FGameplayEventCompressedLogReader::FGameplayEventCompressedLogReader()
+{
+}
+
+FGameplayEventCompressedLogReader::~FGameplayEventCompressedLogReader()
+{
+    Close();
+}
+
+bool FGameplayEventCompressedLogReader::Open(const FString& InFilePath)
+{
+    Close();
+
+    FilePath = InFilePath;
+    Ar.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Ar)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to open compressed log: %s"), *FilePath);
+        return false;
+    }
+
+    const int64 FileSize = Ar->TotalSize();
+    FGameplayEventCompressedFileHeader FileHeader;
+    if (FileSize < static_cast<int64>(sizeof(FileHeader)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Compressed log is truncated: %s"), *FilePath);
+        Close();
+        return false;
+    }
+
+    Ar->Serialize(&FileHeader, sizeof(FileHeader));
+
+    if (FileHeader.Magic != GameplayEventCompressedLog::FileMagic || FileHeader.Version != GameplayEventCompressedLog::Version
+        || FileHeader.HeaderSize < sizeof(FileHeader))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Unsupported compressed log (magic %08x, version %d): %s"),
+            FileHeader.Magic, FileHeader.Version, *FilePath);
+        Close();
+        return false;
+    }
+
+    if (!ReadIndex(FileSize))
+    {
+        // The writer never reached Close, e.g. the game crashed; every complete block is still usable
+        ScanBlocks(FileHeader.HeaderSize, FileSize);
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] Compressed log has no block index, recovered %d blocks: %s"), Blocks.Num(), *FilePath);
+    }
+
+    return true;
+}
+
+void FGameplayEventCompressedLogReader::Close()
+{
+    Ar.Reset();
+    Blocks.Empty();
+    CompressedScratch.Empty();
+}
+
+bool FGameplayEventCompressedLogReader::ReadIndex(int64 FileSize)
+{
+    FGameplayEventCompressedFooter Footer;
+    if (FileSize < static_cast<int64>(sizeof(FGameplayEventCompressedFileHeader) + sizeof(Footer)))
+    {
+        return false;
+    }
+
+    Ar->Seek(FileSize - sizeof(Footer));
+    Ar->Serialize(&Footer, sizeof(Footer));
+
+    const uint64 IndexBytes = static_cast<uint64>(Footer.NumBlocks) * sizeof(FGameplayEventCompressedIndexEntry);
+    if (Ar->IsError() || Footer.Magic != GameplayEventCompressedLog::FooterMagic
+        || Footer.IndexOffset + IndexBytes + sizeof(Footer) != static_cast<uint64>(FileSize))
+    {
+        return false;
+    }
+
+    Blocks.SetNumUninitialized(static_cast<int32>(Footer.NumBlocks));
+    Ar->Seek(static_cast<int64>(Footer.IndexOffset));
+    Ar->Serialize(Blocks.GetData(), static_cast<int64>(IndexBytes));
+
+    if (Ar->IsError())
+    {
+        Blocks.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FGameplayEventCompressedLogReader::ScanBlocks(int64 Offset, int64 FileSize)
+{
+    Blocks.Reset();
+
+    while (Offset + static_cast<int64>(sizeof(FGameplayEventCompressedBlockHeader)) <= FileSize)
+    {
+        FGameplayEventCompressedIndexEntry Entry;
+        Entry.Offset = static_cast<uint64>(Offset);
+
+        Ar->Seek(Offset);
+        Ar->Serialize(&Entry.Block, sizeof(Entry.Block));
+
+        const int64 BlockEnd = Offset + sizeof(Entry.Block) + Entry.Block.CompressedSize;
+        if (Ar->IsError() || Entry.Block.Magic != GameplayEventCompressedLog::BlockMagic || BlockEnd > FileSize)
+        {
+            // Partially written last block
+            break;
+        }
+
+        Blocks.Add(Entry);
+        Offset = BlockEnd;
+    }
+}
+
+void FGameplayEventCompressedLogReader::FindBlocksInGameTimeRange(float MinGameTime, float MaxGameTime, TArray<int32>& OutBlockIndices) const
+{
+    for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+    {
+        const FGameplayEventCompressedBlockHeader& Block = Blocks[BlockIndex].Block;
+        if (Block.MaxGameTime >= MinGameTime && Block.MinGameTime <= MaxGameTime)
+        {
+            OutBlockIndices.Add(BlockIndex);
+        }
+    }
+}
+
+bool FGameplayEventCompressedLogReader::DecompressBlock(int32 BlockIndex, TArray<uint8>& OutRows)
+{
+    if (!Ar || !Blocks.IsValidIndex(BlockIndex))
+    {
+        return false;
+    }
+
+    const FGameplayEventCompressedIndexEntry& Entry = Blocks[BlockIndex];
+    const FGameplayEventCompressedBlockHeader& Block = Entry.Block;
+    const EGameplayEventCompression BlockCompression = static_cast<EGameplayEventCompression>(Block.Compression);
+
+    OutRows.SetNumUninitialized(static_cast<int32>(Block.UncompressedSize));
+    Ar->Seek(static_cast<int64>(Entry.Offset + sizeof(Block)));
+
+    if (BlockCompression == EGameplayEventCompression::None)
+    {
+        if (Block.CompressedSize != Block.UncompressedSize)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Raw block %d has mismatched sizes: %s"), BlockIndex, *FilePath);
+            return false;
+        }
+
+        Ar->Serialize(OutRows.GetData(), OutRows.Num());
+        return !Ar->IsError();
+    }
+
+    CompressedScratch.SetNumUninitialized(static_cast<int32>(Block.CompressedSize));
+    Ar->Serialize(CompressedScratch.GetData(), CompressedScratch.Num());
+
+    const FName FormatName = GameplayEventCompressedLog::GetFormatName(BlockCompression);
+    if (Ar->IsError() || FormatName.IsNone()
+        || !FCompression::UncompressMemory(FormatName, OutRows.GetData(), OutRows.Num(), CompressedScratch.GetData(), CompressedScratch.Num()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to decompress block %d (codec %d): %s"), BlockIndex, Block.Compression, *FilePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool FGameplayEventCompressedLogReader::ConvertToCSV(const FString& CompressedPath, const FString& CSVPath, float MinGameTime, float MaxGameTime)
+{
+    FGameplayEventCompressedLogReader Reader;
+    if (!Reader.Open(CompressedPath))
+    {
+        return false;
+    }
+
+    const float UpperBound = MaxGameTime < 0.f ? TNumericLimits<float>::Max() : MaxGameTime;
+
+    TArray<int32> BlockIndices;
+    Reader.FindBlocksInGameTimeRange(MinGameTime, UpperBound, BlockIndices);
+
+    TUniquePtr<FArchive> Out(IFileManager::Get().CreateFileWriter(*CSVPath));
+    if (!Out)
+    {
+        return false;
+    }
+
+    const FTCHARToUTF8 Header(FGameplayEventCSVWriter::Header);
+    Out->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+
+    TArray<uint8> Rows;
+    for (const int32 BlockIndex : BlockIndices)
+    {
+        // Blocks are independent: a corrupt one only loses its own rows
+        if (!Reader.DecompressBlock(BlockIndex, Rows))
+        {
+            continue;
+        }
+
+        const FGameplayEventCompressedBlockHeader& Block = Reader.GetBlocks()[BlockIndex].Block;
+        if (Block.MinGameTime >= MinGameTime && Block.MaxGameTime <= UpperBound)
+        {
+            Out->Serialize(Rows.GetData(), Rows.Num());
+            continue;
+        }
+
+        // The block straddles the range: keep rows by their leading GameTime column
+        int32 LineStart = 0;
+        while (LineStart < Rows.Num())
+        {
+            int32 LineEnd = LineStart;
+            while (LineEnd < Rows.Num() && Rows[LineEnd] != '\n')
+            {
+                ++LineEnd;
+            }
+            LineEnd = FMath::Min(LineEnd + 1, Rows.Num());
+
+            ANSICHAR GameTimeText[32];
+            int32 Length = 0;
+            while (Length < static_cast<int32>(UE_ARRAY_COUNT(GameTimeText)) - 1 && LineStart + Length < LineEnd && Rows[LineStart + Length] != ',')
+            {
+                GameTimeText[Length] = static_cast<ANSICHAR>(Rows[LineStart + Length]);
+                ++Length;
+            }
+            GameTimeText[Length] = 0;
+
+            const float GameTime = FCStringAnsi::Atof(GameTimeText);
+            if (GameTime >= MinGameTime && GameTime <= UpperBound)
+            {
+                Out->Serialize(&Rows[LineStart], LineEnd - LineStart);
+            }
+
+            LineStart = LineEnd;
+        }
+    }
+
+    const bool bSuccess = !Out->IsError();
+    const bool bClosed = Out->Close();
+    return bClosed && bSuccess;
+}
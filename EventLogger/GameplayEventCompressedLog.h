@@ -0,0 +1,215 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventCSVWriter.h"
+#include "GameplayEventFields.h"
+
+class FArchive;
+class FGameplayEventStringTable;
+struct FGameplayEventCompressionStats;
+struct FGameplayEventRecord;
+enum class EGameplayEventCompression : uint8;
+
+/**
+ * Compressed event log format (.gelz)
+ * -----------------------------------
+ * [FGameplayEventCompressedFileHeader]
+ * [FGameplayEventCompressedBlockHeader, CompressedSize payload bytes]   repeated per block
+ * [NumBlocks x FGameplayEventCompressedIndexEntry]                      written on close
+ * [FGameplayEventCompressedFooter]                                      last bytes of the file
+ *
+ * Every block holds UTF-8 CSV rows in the ExportLogToCSV layout (without the header line),
+ * compressed on its own so any block can be decompressed without the others. The index
+ * lists each block's offset and game/UTC time range, so tools can seek to a time window
+ * and only decompress the blocks that overlap it.
+ *
+ * Block headers repeat their index entry: a file cut short by a crash has no index, but
+ * is still read completely by walking the block headers. All values are little-endian.
+ */
+namespace GameplayEventCompressedLog
+{
+    /** 'GELZ' */
+    constexpr uint32 FileMagic = 0x5A4C4547;
+
+    /** 'GEBK' */
+    constexpr uint32 BlockMagic = 0x4B424547;
+
+    /** 'GEIX' */
+    constexpr uint32 FooterMagic = 0x58494547;
+
+    constexpr uint16 Version = 1;
+
+    /** FCompression format name of a codec; NAME_None for EGameplayEventCompression::None. */
+    YOURPROJECT_API FName GetFormatName(EGameplayEventCompression Compression);
+}
+
+struct FGameplayEventCompressedFileHeader
+{
+    uint32 Magic = GameplayEventCompressedLog::FileMagic;
+    uint16 Version = GameplayEventCompressedLog::Version;
+    uint16 HeaderSize = sizeof(FGameplayEventCompressedFileHeader);
+};
+
+struct FGameplayEventCompressedBlockHeader
+{
+    uint32 Magic = GameplayEventCompressedLog::BlockMagic;
+
+    /** EGameplayEventCompression of the payload. None when the block did not compress and is stored raw. */
+    uint8 Compression = 0;
+    uint8 Reserved[3] = {};
+
+    uint32 CompressedSize = 0;
+    uint32 UncompressedSize = 0;
+    uint32 NumRecords = 0;
+    float MinGameTime = 0.f;
+    float MaxGameTime = 0.f;
+    uint32 Reserved2 = 0;
+    int64 MinUtcTicks = 0;
+    int64 MaxUtcTicks = 0;
+};
+
+struct FGameplayEventCompressedIndexEntry
+{
+    /** File offset of the block header. */
+    uint64 Offset = 0;
+
+    FGameplayEventCompressedBlockHeader Block;
+};
+
+struct FGameplayEventCompressedFooter
+{
+    uint64 IndexOffset = 0;
+    uint32 NumBlocks = 0;
+    uint32 Magic = GameplayEventCompressedLog::FooterMagic;
+};
+
+static_assert(sizeof(FGameplayEventCompressedFileHeader) == 8, "Compressed event log header layout changed, bump the version.");
+static_assert(sizeof(FGameplayEventCompressedBlockHeader) == 48, "Compressed event log block layout changed, bump the version.");
+static_assert(sizeof(FGameplayEventCompressedIndexEntry) == 56, "Compressed event log index layout changed, bump the version.");
+static_assert(sizeof(FGameplayEventCompressedFooter) == 16, "Compressed event log footer layout changed, bump the version.");
+
+/**
+ * FGameplayEventCompressedLogWriter
+ * ---------------------------------
+ * Formats records as CSV rows and writes them to a .gelz file one compressed block at a
+ * time. A block is sealed once its rows reach the block size, or earlier through SealBlock;
+ * each sealed block is flushed to the OS. Close appends the block index.
+ *
+ * Tracks the bytes in and out of the codec and the CPU time spent compressing, see GetStats.
+ * Not thread-safe.
+ */
+class YOURPROJECT_API FGameplayEventCompressedLogWriter
+{
+public:
+    /** Default uncompressed size of one block. Larger blocks compress better but are coarser to seek. */
+    static constexpr int32 DefaultBlockBytes = 256 * 1024;
+
+    /** InFields must outlive the writer and hold the fields of records written without explicit fields; may be null. */
+    FGameplayEventCompressedLogWriter(const FGameplayEventStringTable& InStrings, const FGameplayEventClock& InClock, EGameplayEventCompression InCompression,
+        const FGameplayEventFieldSnapshot* InFields = nullptr, int32 InBlockBytes = DefaultBlockBytes);
+    ~FGameplayEventCompressedLogWriter();
+
+    /** Creates (or truncates) FilePath and writes the file header. Returns false if the file could not be opened. */
+    bool Open(const FString& FilePath);
+
+    /** Appends rows for Records, taking their fields from the snapshot. Requires Open. */
+    void Write(TArrayView<const FGameplayEventRecord> Records);
+
+    /** Appends the row of a record whose fields are not in storage. Requires Open. */
+    void Write(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> RecordFields);
+
+    /** Compresses and writes the buffered rows as one block, even if it is not full. Returns false on a write error. */
+    bool SealBlock();
+
+    /** Seals the last block, writes the index and closes. Returns true if every write succeeded. */
+    bool Close();
+
+    /** Records buffered for the next block. */
+    int32 GetNumPendingRecords() const { return static_cast<int32>(PendingBlock.NumRecords); }
+
+    /** Records in blocks that reached the file. */
+    uint64 GetNumRecordsWritten() const { return NumRecordsWritten; }
+
+    /** Records in blocks that failed to write. */
+    uint64 GetNumRecordsLost() const { return NumRecordsLost; }
+
+    /** Compression ratio and cost over every block written so far. */
+    void GetStats(FGameplayEventCompressionStats& OutStats) const;
+
+private:
+    /** Widens the pending block's ranges with Record and seals the block once it is full. */
+    void AddToPendingBlock(const FGameplayEventRecord& Record);
+
+    /** Only used to format rows; never opened. */
+    FGameplayEventCSVWriter Rows;
+    FGameplayEventClock Clock;
+    EGameplayEventCompression Compression;
+
+    /** Uncompressed block size, counted in characters; rows are nearly all ASCII. */
+    int32 BlockBytes;
+
+    /** Rows of the block being filled; Reset keeps its allocation between blocks. */
+    FString PendingRows;
+    FGameplayEventCompressedBlockHeader PendingBlock;
+
+    /** Codec output, reused between blocks. */
+    TArray<uint8> CompressedScratch;
+
+    TArray<FGameplayEventCompressedIndexEntry> Index;
+    TUniquePtr<FArchive> Ar;
+
+    uint64 NumRecordsWritten = 0;
+    uint64 NumRecordsLost = 0;
+    uint64 UncompressedBytes = 0;
+    uint64 CompressedBytes = 0;
+    uint64 CompressCycles = 0;
+};
+
+/**
+ * FGameplayEventCompressedLogReader
+ * ---------------------------------
+ * Opens a .gelz file and loads its block index, or rebuilds it from the block headers
+ * when the file was not closed. Blocks are read and decompressed on demand.
+ */
+class YOURPROJECT_API FGameplayEventCompressedLogReader
+{
+public:
+    FGameplayEventCompressedLogReader();
+    ~FGameplayEventCompressedLogReader();
+
+    /** Opens and validates FilePath. Returns false (and logs why) on a missing or malformed file. */
+    bool Open(const FString& FilePath);
+
+    void Close();
+
+    /** Blocks in file order. */
+    TArrayView<const FGameplayEventCompressedIndexEntry> GetBlocks() const { return Blocks; }
+
+    /** Appends the indices of blocks holding events with a game time in [MinGameTime, MaxGameTime]. */
+    void FindBlocksInGameTimeRange(float MinGameTime, float MaxGameTime, TArray<int32>& OutBlockIndices) const;
+
+    /** Reads one block and decompresses its UTF-8 CSV rows into OutRows. Returns false on a read or codec error. */
+    bool DecompressBlock(int32 BlockIndex, TArray<uint8>& OutRows);
+
+    /**
+     * Writes the events with a game time in [MinGameTime, MaxGameTime] of a .gelz file to a CSV
+     * file in the ExportLogToCSV layout. A negative MaxGameTime means no upper bound.
+     * Only blocks overlapping the range are decompressed. Returns success.
+     */
+    static bool ConvertToCSV(const FString& CompressedPath, const FString& CSVPath, float MinGameTime = 0.f, float MaxGameTime = -1.f);
+
+private:
+    /** Loads the index from the footer. Returns false if the file has no valid footer. */
+    bool ReadIndex(int64 FileSize);
+
+    /** Rebuilds the index by walking block headers from Offset, stopping at the first incomplete block. */
+    void ScanBlocks(int64 Offset, int64 FileSize);
+
+    FString FilePath;
+    TUniquePtr<FArchive> Ar;
+    TArray<FGameplayEventCompressedIndexEntry> Blocks;
+
+    /** Compressed payload, reused between blocks. */
+    TArray<uint8> CompressedScratch;
+};
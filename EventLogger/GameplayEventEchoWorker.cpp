@@ -0,0 +1,82 @@
+#include "GameplayEventEchoWorker.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventStringTable.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FGameplayEventEchoWorker::FGameplayEventEchoWorker(TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> InStrings, const FGameplayEventClock& InClock, uint32 QueueCapacity, float InFlushIntervalSeconds)
+    : Strings(MoveTemp(InStrings))
+    , Clock(InClock)
+    , Pending(QueueCapacity)
+    , FlushIntervalSeconds(FMath::Max(InFlushIntervalSeconds, 0.01f))
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("GameplayEventEcho"), 0, TPri_BelowNormal);
+}
+
+FGameplayEventEchoWorker::~FGameplayEventEchoWorker()
+{
+    if (Thread)
+    {
+        // Kill(true) calls Stop() and waits, so the final batch is flushed by Run()
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+bool FGameplayEventEchoWorker::Enqueue(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields)
+{
+    FGameplayEventPendingRecord Copy{ Record, TArray<FGameplayEventField>(Fields) };
+    if (!Pending.TryEnqueue(MoveTemp(Copy)))
+    {
+        NumSkipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+uint32 FGameplayEventEchoWorker::Run()
+{
+    const uint32 WaitMs = static_cast<uint32>(FlushIntervalSeconds * 1000.f);
+
+    while (!bStopRequested.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(WaitMs);
+        FlushBatch();
+    }
+
+    FlushBatch();
+    return 0;
+}
+
+void FGameplayEventEchoWorker::Stop()
+{
+    bStopRequested.store(true, std::memory_order_release);
+    WakeEvent->Trigger();
+}
+
+void FGameplayEventEchoWorker::FlushBatch()
+{
+    Batch.Reset();
+
+    const int32 NumDrained = Pending.Drain([this](FGameplayEventPendingRecord&& Item)
+    {
+        const FGameplayEventRecord& Record = Item.Record;
+
+        FieldText.Reset();
+        FGameplayEventField::AppendAll(Item.Fields, 0, Item.Fields.Num(), FieldText);
+
+        Batch.Appendf(TEXT("\n  Event: '%s' | Context: '%s' | Fields: '%s' | GameTime: %.3f | UTC: %s"),
+            *Strings->Resolve(Record.NameId), *Record.Context, *FieldText, Record.GameTime, *Clock.ToUtc(Record.Cycles).ToString());
+    });
+
+    if (NumDrained > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] %d event(s) logged:%s"), NumDrained, *Batch);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventRingBuffer.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+class FGameplayEventStringTable;
+struct FGameplayEventField;
+struct FGameplayEventPendingRecord;
+struct FGameplayEventRecord;
+
+/**
+ * FGameplayEventEchoWorker
+ * ------------------------
+ * Background thread that echoes logged events to the output log.
+ *
+ * LogEvent only pushes the compact record into a lock-free queue; timestamp formatting,
+ * string resolution and UE_LOG happen on this thread, batched into one log line per
+ * flush interval. Events that do not fit in the queue are skipped (the log itself keeps them).
+ */
+class YOURPROJECT_API FGameplayEventEchoWorker : public FRunnable
+{
+public:
+    FGameplayEventEchoWorker(TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> InStrings, const FGameplayEventClock& InClock, uint32 QueueCapacity, float InFlushIntervalSeconds);
+    virtual ~FGameplayEventEchoWorker();
+
+    /** Queues a record and a copy of its fields for echoing. Safe from any thread. Returns false if the queue is full. */
+    bool Enqueue(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields);
+
+    /** Number of records skipped because the queue was full. */
+    uint64 GetNumSkipped() const { return NumSkipped.load(std::memory_order_relaxed); }
+
+    //~ Begin FRunnable Interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    //~ End FRunnable Interface
+
+private:
+    /** Drains the queue and writes everything as one log line. */
+    void FlushBatch();
+
+    TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> Strings;
+    FGameplayEventClock Clock;
+    TGameplayEventRingBuffer<FGameplayEventPendingRecord> Pending;
+    float FlushIntervalSeconds;
+
+    /** Reused between flushes so steady-state batching does not allocate. */
+    FString Batch;
+    FString FieldText;
+
+    std::atomic<bool> bStopRequested{ false };
+    std::atomic<uint64> NumSkipped{ 0 };
+
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
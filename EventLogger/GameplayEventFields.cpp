@@ -0,0 +1,125 @@
+#include "GameplayEventFields.h"
+#include "UObject/Object.h"
+
+FGameplayEventField FGameplayEventField::MakeInt(FName InKey, int64 Value)
+{
+    FGameplayEventField Field;
+    Field.Key = InKey;
+    Field.Type = EGameplayEventFieldType::Int;
+    Field.Store(Value);
+    return Field;
+}
+
+FGameplayEventField FGameplayEventField::MakeDouble(FName InKey, double Value)
+{
+    FGameplayEventField Field;
+    Field.Key = InKey;
+    Field.Type = EGameplayEventFieldType::Double;
+    Field.Store(Value);
+    return Field;
+}
+
+FGameplayEventField FGameplayEventField::MakeVector(FName InKey, const FVector& Value)
+{
+    FGameplayEventField Field;
+    Field.Key = InKey;
+    Field.Type = EGameplayEventFieldType::Vector;
+    Field.Store(Value);
+    return Field;
+}
+
+FGameplayEventField FGameplayEventField::MakeName(FName InKey, FName Value)
+{
+    FGameplayEventField Field;
+    Field.Key = InKey;
+    Field.Type = EGameplayEventFieldType::Name;
+    Field.Store(Value);
+    return Field;
+}
+
+FGameplayEventField FGameplayEventField::MakeObject(FName InKey, const UObject* Object)
+{
+    FGameplayEventField Field;
+    Field.Key = InKey;
+    Field.Type = EGameplayEventFieldType::Object;
+    Field.Store(static_cast<uint64>(Object ? Object->GetUniqueID() : 0));
+    Field.Store(Object ? Object->GetFName() : FName(NAME_None), sizeof(uint64));
+    return Field;
+}
+
+int64 FGameplayEventField::GetInt() const
+{
+    switch (Type)
+    {
+    case EGameplayEventFieldType::Int:
+        return Load<int64>();
+    case EGameplayEventFieldType::Object:
+        return static_cast<int64>(Load<uint64>());
+    default:
+        return 0;
+    }
+}
+
+double FGameplayEventField::GetDouble() const
+{
+    switch (Type)
+    {
+    case EGameplayEventFieldType::Double:
+        return Load<double>();
+    case EGameplayEventFieldType::Int:
+        return static_cast<double>(Load<int64>());
+    default:
+        return 0.0;
+    }
+}
+
+FVector FGameplayEventField::GetVector() const
+{
+    return Type == EGameplayEventFieldType::Vector ? Load<FVector>() : FVector::ZeroVector;
+}
+
+FName FGameplayEventField::GetName() const
+{
+    switch (Type)
+    {
+    case EGameplayEventFieldType::Name:
+        return Load<FName>();
+    case EGameplayEventFieldType::Object:
+        return Load<FName>(sizeof(uint64));
+    default:
+        return NAME_None;
+    }
+}
+
+void FGameplayEventField::AppendTo(FString& Out) const
+{
+    Key.AppendString(Out);
+    Out += TEXT('=');
+
+    switch (Type)
+    {
+    case EGameplayEventFieldType::Int:
+        Out.Appendf(TEXT("%lld"), Load<int64>());
+        break;
+
+    case EGameplayEventFieldType::Double:
+        Out += FString::SanitizeFloat(Load<double>());
+        break;
+
+    case EGameplayEventFieldType::Vector:
+    {
+        const FVector Value = Load<FVector>();
+        Out.Appendf(TEXT("(%.3f,%.3f,%.3f)"), Value.X, Value.Y, Value.Z);
+        break;
+    }
+
+    case EGameplayEventFieldType::Name:
+        Load<FName>().AppendString(Out);
+        break;
+
+    case EGameplayEventFieldType::Object:
+        Load<FName>(sizeof(uint64)).AppendString(Out);
+        Out.Appendf(TEXT("#%llu"), Load<uint64>());
+        break;
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventSegmentedLog.h"
+
+/** Value type held by an FGameplayEventField. */
+enum class EGameplayEventFieldType : uint8
+{
+    Int,
+    Double,
+    Vector,
+    Name,
+
+    /** UObject unique id plus its name at log time; the object itself is not referenced. */
+    Object
+};
+
+/**
+ * FGameplayEventField
+ * -------------------
+ * One typed key/value pair attached to a logged event. Fixed size and trivially copyable,
+ * so fields live in the logger's segmented storage next to the records that own them.
+ *
+ * Values are stored raw and only turned into text by AppendTo, which runs when an event
+ * is dumped, echoed or exported rather than when it is logged.
+ */
+struct YOURPROJECT_API FGameplayEventField
+{
+    FName Key;
+
+    EGameplayEventFieldType Type = EGameplayEventFieldType::Int;
+
+    static FGameplayEventField MakeInt(FName InKey, int64 Value);
+    static FGameplayEventField MakeDouble(FName InKey, double Value);
+    static FGameplayEventField MakeVector(FName InKey, const FVector& Value);
+    static FGameplayEventField MakeName(FName InKey, FName Value);
+    static FGameplayEventField MakeObject(FName InKey, const UObject* Object);
+
+    /** Overloads picking the field type from the C++ value type, used by builders and schemas. */
+    template <typename IntType, typename = typename TEnableIf<TIsIntegral<IntType>::Value>::Type>
+    static FGameplayEventField Make(FName InKey, IntType Value)
+    {
+        // Every integer width and signedness is stored as int64; uint64 values above INT64_MAX wrap
+        return MakeInt(InKey, static_cast<int64>(Value));
+    }
+
+    static FGameplayEventField Make(FName InKey, float Value) { return MakeDouble(InKey, Value); }
+    static FGameplayEventField Make(FName InKey, double Value) { return MakeDouble(InKey, Value); }
+    static FGameplayEventField Make(FName InKey, const FVector& Value) { return MakeVector(InKey, Value); }
+    static FGameplayEventField Make(FName InKey, FName Value) { return MakeName(InKey, Value); }
+    static FGameplayEventField Make(FName InKey, const UObject* Value) { return MakeObject(InKey, Value); }
+
+    /** Int value, or the object unique id for Object fields. 0 for other types. */
+    int64 GetInt() const;
+
+    /** Double value; Int fields are converted. 0 for other types. */
+    double GetDouble() const;
+
+    /** Vector value, zero for other types. */
+    FVector GetVector() const;
+
+    /** Name value, or the object name for Object fields. NAME_None for other types. */
+    FName GetName() const;
+
+    /** Appends "Key=Value". */
+    void AppendTo(FString& Out) const;
+
+    /** Appends Num fields of Source starting at FirstIndex as "Key=Value" pairs separated by ';'. */
+    template <typename FieldSourceType>
+    static void AppendAll(const FieldSourceType& Source, int32 FirstIndex, int32 Num, FString& Out)
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            if (Index > 0)
+            {
+                Out += TEXT(';');
+            }
+            Source[FirstIndex + Index].AppendTo(Out);
+        }
+    }
+
+private:
+    static constexpr SIZE_T ObjectStorageSize = sizeof(uint64) + sizeof(FName);
+    static constexpr SIZE_T StorageSize = sizeof(FVector) > ObjectStorageSize ? sizeof(FVector) : ObjectStorageSize;
+
+    template <typename ValueType>
+    void Store(const ValueType& Value, SIZE_T Offset = 0)
+    {
+        static_assert(TIsTriviallyDestructible<ValueType>::Value, "Field values are stored as raw bytes");
+        check(Offset + sizeof(ValueType) <= StorageSize);
+        FMemory::Memcpy(Storage + Offset, &Value, sizeof(ValueType));
+    }
+
+    template <typename ValueType>
+    ValueType Load(SIZE_T Offset = 0) const
+    {
+        ValueType Value;
+        FMemory::Memcpy(&Value, Storage + Offset, sizeof(ValueType));
+        return Value;
+    }
+
+    alignas(8) uint8 Storage[StorageSize] = {};
+};
+
+using FGameplayEventFieldSnapshot = TGameplayEventLogSnapshot<FGameplayEventField>;
+
+/**
+ * FGameplayEventFields
+ * --------------------
+ * Builder for the typed fields passed to UGameplayEventLogger::LogStructuredEvent:
+ *
+ *     Logger->LogStructuredEvent(TEXT("Damage"), FGameplayEventFields()
+ *         .Add(TEXT("Amount"), Damage)
+ *         .Add(TEXT("Location"), HitLocation)
+ *         .Add(TEXT("Instigator"), InstigatorActor));
+ *
+ * Adding a field copies the raw value; nothing is formatted.
+ */
+class YOURPROJECT_API FGameplayEventFields
+{
+public:
+    /** Adds a field; the type follows the overloads of FGameplayEventField::Make. */
+    template <typename ValueType>
+    FGameplayEventFields& Add(FName Key, const ValueType& Value)
+    {
+        Fields.Add(FGameplayEventField::Make(Key, Value));
+        return *this;
+    }
+
+    int32 Num() const { return Fields.Num(); }
+
+    TArrayView<const FGameplayEventField> GetFields() const { return Fields; }
+
+    /** Gives up the field array, used by the logger to move it into its queues without copying. */
+    TArray<FGameplayEventField> Release() { return MoveTemp(Fields); }
+
+private:
+    TArray<FGameplayEventField> Fields;
+};
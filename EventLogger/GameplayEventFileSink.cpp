@@ -0,0 +1,285 @@
+#include "GameplayEventFileSink.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventStringTable.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+namespace GameplayEventFileSinkPrivate
+{
+    /** How long the crash hook waits for the sink thread to release the file. */
+    constexpr double CrashFlushTimeoutSeconds = 0.5;
+
+    /** Holds the sink's write mutex and records the holding thread, so the crash hook can tell whether it runs on it. */
+    class FWriteScope
+    {
+    public:
+        FWriteScope(FCriticalSection& InMutex, std::atomic<uint32>& InOwnerThreadId)
+            : Mutex(InMutex)
+            , OwnerThreadId(InOwnerThreadId)
+        {
+            Mutex.Lock();
+            OwnerThreadId.store(FPlatformTLS::GetCurrentThreadId(), std::memory_order_relaxed);
+        }
+
+        ~FWriteScope()
+        {
+            OwnerThreadId.store(0, std::memory_order_relaxed);
+            Mutex.Unlock();
+        }
+
+    private:
+        FCriticalSection& Mutex;
+        std::atomic<uint32>& OwnerThreadId;
+    };
+}
+
+FGameplayEventFileSink::FGameplayEventFileSink(TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> InStrings, const FGameplayEventClock& InClock,
+    const FString& InFilePath, uint32 QueueCapacity, float InFlushIntervalSeconds,
+    EGameplayEventCompression Compression, int32 InBlockBytes, float InMaxBlockSeconds)
+    : Strings(MoveTemp(InStrings))
+    , FilePath(InFilePath)
+    , Pending(QueueCapacity)
+    , FlushIntervalSeconds(FMath::Max(InFlushIntervalSeconds, 0.01f))
+    , MaxBlockSeconds(FMath::Max(InMaxBlockSeconds, 0.01f))
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    if (Compression != EGameplayEventCompression::None)
+    {
+        CompressedWriter = MakeUnique<FGameplayEventCompressedLogWriter>(*Strings, InClock, Compression, nullptr, InBlockBytes);
+        if (!CompressedWriter->Open(FilePath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to open file sink: %s"), *FilePath);
+            CompressedWriter.Reset();
+            return;
+        }
+    }
+    else
+    {
+        const bool bWriteHeader = !PlatformFile.FileExists(*FilePath);
+        File.Reset(PlatformFile.OpenWrite(*FilePath, /*bAppend=*/ true));
+
+        if (!File)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to open file sink: %s"), *FilePath);
+            return;
+        }
+
+        if (bWriteHeader)
+        {
+            const FTCHARToUTF8 Header(FGameplayEventCSVWriter::Header);
+            File->Write(reinterpret_cast<const uint8*>(Header.Get()), Header.Length());
+        }
+
+        Writer = MakeUnique<FGameplayEventCSVWriter>(*Strings, InClock);
+    }
+    SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddRaw(this, &FGameplayEventFileSink::HandleSystemError);
+
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("GameplayEventFileSink"), 0, TPri_BelowNormal);
+}
+
+FGameplayEventFileSink::~FGameplayEventFileSink()
+{
+    FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+
+    if (Thread)
+    {
+        // Kill(true) calls Stop() and waits, so the final batch is written by Run()
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WakeEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+        WakeEvent = nullptr;
+    }
+
+    if (CompressedWriter)
+    {
+        // Appends the block index; the final block was sealed by Run()
+        CompressedWriter->Close();
+
+        FGameplayEventCompressionStats Stats;
+        CompressedWriter->GetStats(Stats);
+        UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] File sink %s: %d blocks, %.2f MB -> %.2f MB (%.1fx), %.2f ms CPU per MB"),
+            *FilePath, Stats.NumBlocks, Stats.UncompressedBytes / (1024.0 * 1024.0), Stats.CompressedBytes / (1024.0 * 1024.0),
+            Stats.CompressionRatio, Stats.CompressMillisecondsPerMB);
+        CompressedWriter.Reset();
+    }
+
+    File.Reset();
+}
+
+bool FGameplayEventFileSink::Enqueue(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    FGameplayEventPendingRecord Copy{ Record, TArray<FGameplayEventField>(Fields) };
+    if (!Pending.TryEnqueue(MoveTemp(Copy)))
+    {
+        NumDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Wake the sink early instead of letting a burst fill the queue
+    if (Pending.GetApproximateNum() > Pending.GetCapacity() / 2)
+    {
+        WakeEvent->Trigger();
+    }
+    return true;
+}
+
+void FGameplayEventFileSink::Flush()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    GameplayEventFileSinkPrivate::FWriteScope Lock(WriteMutex, WriteMutexOwner);
+    WriteBatch_Locked(/*bSealBlock=*/ true);
+}
+
+bool FGameplayEventFileSink::GetCompressionStats(FGameplayEventCompressionStats& OutStats) const
+{
+    GameplayEventFileSinkPrivate::FWriteScope Lock(WriteMutex, WriteMutexOwner);
+
+    if (!CompressedWriter)
+    {
+        return false;
+    }
+
+    CompressedWriter->GetStats(OutStats);
+    return true;
+}
+
+uint32 FGameplayEventFileSink::Run()
+{
+    const uint32 WaitMs = static_cast<uint32>(FlushIntervalSeconds * 1000.f);
+
+    while (!bStopRequested.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(WaitMs);
+
+        GameplayEventFileSinkPrivate::FWriteScope Lock(WriteMutex, WriteMutexOwner);
+        WriteBatch_Locked(/*bSealBlock=*/ false);
+    }
+
+    GameplayEventFileSinkPrivate::FWriteScope Lock(WriteMutex, WriteMutexOwner);
+    WriteBatch_Locked(/*bSealBlock=*/ true);
+    return 0;
+}
+
+void FGameplayEventFileSink::Stop()
+{
+    bStopRequested.store(true, std::memory_order_release);
+    WakeEvent->Trigger();
+}
+
+void FGameplayEventFileSink::WriteBatch_Locked(bool bSealBlock)
+{
+    if (CompressedWriter)
+    {
+        WriteCompressedBatch_Locked(bSealBlock);
+        return;
+    }
+
+    if (!File)
+    {
+        return;
+    }
+
+    Batch.Reset();
+
+    const int32 NumDrained = Pending.Drain([this](FGameplayEventPendingRecord&& Item)
+    {
+        Writer->AppendRow(Item.Record, Item.Fields, Batch);
+    });
+
+    if (NumDrained == 0)
+    {
+        return;
+    }
+
+    const FTCHARToUTF8 Converted(*Batch);
+    if (!File->Write(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to write %d events to file sink %s."), NumDrained, *FilePath);
+        NumDropped.fetch_add(NumDrained, std::memory_order_relaxed);
+        return;
+    }
+
+    // Hand the data to the OS now, so it survives the process dying before the next batch
+    File->Flush();
+    NumWritten.fetch_add(NumDrained, std::memory_order_relaxed);
+}
+
+void FGameplayEventFileSink::WriteCompressedBatch_Locked(bool bSealBlock)
+{
+    // Full blocks are sealed by the writer as rows come in
+    Pending.Drain([this](FGameplayEventPendingRecord&& Item)
+    {
+        CompressedWriter->Write(Item.Record, Item.Fields);
+    });
+
+    const double Now = FPlatformTime::Seconds();
+    if (CompressedWriter->GetNumPendingRecords() == 0)
+    {
+        PendingBlockStartSeconds = 0.0;
+    }
+    else if (PendingBlockStartSeconds == 0.0)
+    {
+        PendingBlockStartSeconds = Now;
+    }
+
+    if (PendingBlockStartSeconds > 0.0 && (bSealBlock || Now - PendingBlockStartSeconds >= MaxBlockSeconds))
+    {
+        CompressedWriter->SealBlock();
+        PendingBlockStartSeconds = 0.0;
+    }
+
+    const uint64 NumLost = CompressedWriter->GetNumRecordsLost();
+    if (NumLost > NumLostInFile.load(std::memory_order_relaxed))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to write compressed blocks to file sink %s, %llu events lost so far."), *FilePath, NumLost);
+    }
+
+    NumWritten.store(CompressedWriter->GetNumRecordsWritten(), std::memory_order_relaxed);
+    NumLostInFile.store(NumLost, std::memory_order_relaxed);
+}
+
+void FGameplayEventFileSink::HandleSystemError()
+{
+    // FCriticalSection is recursive, so a crash inside a write on this very thread would let
+    // TryLock succeed and re-enter the half-finished batch; give up on the flush instead
+    if (WriteMutexOwner.load(std::memory_order_relaxed) == FPlatformTLS::GetCurrentThreadId())
+    {
+        return;
+    }
+
+    // The crash may have happened on another thread while it held the mutex; do not wait forever
+    const double Deadline = FPlatformTime::Seconds() + GameplayEventFileSinkPrivate::CrashFlushTimeoutSeconds;
+    while (!WriteMutex.TryLock())
+    {
+        if (FPlatformTime::Seconds() > Deadline)
+        {
+            return;
+        }
+        FPlatformProcess::SleepNoStats(0.001f);
+    }
+
+    WriteBatch_Locked(/*bSealBlock=*/ true);
+    WriteMutex.Unlock();
+}
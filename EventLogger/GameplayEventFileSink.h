@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventCompressedLog.h"
+#include "GameplayEventCSVWriter.h"
+#include "GameplayEventRingBuffer.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+class IFileHandle;
+class FGameplayEventStringTable;
+struct FGameplayEventCompressionStats;
+struct FGameplayEventField;
+struct FGameplayEventPendingRecord;
+struct FGameplayEventRecord;
+
+/**
+ * FGameplayEventFileSink
+ * ----------------------
+ * Background thread that continuously appends logged events to a CSV file, so a crash
+ * only loses the last flush interval instead of the whole session.
+ *
+ * Logging threads copy each event into a bounded lock-free queue and never touch the
+ * file. Every flush interval (or earlier, once the queue is half full) the sink thread
+ * drains the queue into a reusable text buffer and appends it with a single write, while
+ * producers keep filling the queue. Events that do not fit are counted and dropped rather
+ * than blocking the game thread.
+ *
+ * With a compression codec the sink writes a .gelz file instead: rows accumulate into a
+ * block that is compressed and written once it is full or MaxBlockSeconds old, and the
+ * block index is appended when the sink shuts down.
+ *
+ * A fatal-error hook drains and flushes whatever is queued from the crashing thread, unless
+ * that thread crashed in the middle of writing a batch.
+ */
+class YOURPROJECT_API FGameplayEventFileSink : public FRunnable
+{
+public:
+    /** Compression other than None truncates InFilePath and writes blocks of InBlockBytes; otherwise CSV is appended. */
+    FGameplayEventFileSink(TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> InStrings, const FGameplayEventClock& InClock,
+        const FString& InFilePath, uint32 QueueCapacity, float InFlushIntervalSeconds,
+        EGameplayEventCompression Compression, int32 InBlockBytes, float InMaxBlockSeconds);
+    virtual ~FGameplayEventFileSink();
+
+    /** False if the file could not be opened; the sink then ignores every event. */
+    bool IsOpen() const { return File.IsValid() || CompressedWriter.IsValid(); }
+
+    const FString& GetFilePath() const { return FilePath; }
+
+    /** Queues a copy of a record and its fields. Safe from any thread. Returns false if the queue is full. */
+    bool Enqueue(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields);
+
+    /** Writes everything queued so far before returning. Blocks on disk I/O; meant for explicit checkpoints. */
+    void Flush();
+
+    uint64 GetNumWritten() const { return NumWritten.load(std::memory_order_relaxed); }
+    uint64 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed) + NumLostInFile.load(std::memory_order_relaxed); }
+
+    /** Fills OutStats for the blocks written so far. Returns false for an uncompressed sink. */
+    bool GetCompressionStats(FGameplayEventCompressionStats& OutStats) const;
+
+    //~ Begin FRunnable Interface
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+    //~ End FRunnable Interface
+
+private:
+    /** Drains the queue and appends it to the file. bSealBlock forces out a partly filled compressed block. Caller must hold WriteMutex. */
+    void WriteBatch_Locked(bool bSealBlock);
+
+    /** Compressed variant of WriteBatch_Locked. */
+    void WriteCompressedBatch_Locked(bool bSealBlock);
+
+    /** Fatal-error hook: flushes without waiting on a sink thread that may be the one crashing. */
+    void HandleSystemError();
+
+    TSharedRef<const FGameplayEventStringTable, ESPMode::ThreadSafe> Strings;
+    FString FilePath;
+    TGameplayEventRingBuffer<FGameplayEventPendingRecord> Pending;
+    float FlushIntervalSeconds;
+    float MaxBlockSeconds;
+
+    /** Serializes draining, formatting and writing between the sink thread, Flush and the crash hook. */
+    mutable FCriticalSection WriteMutex;
+
+    /** Thread currently holding WriteMutex, 0 when free. Read by the crash hook. */
+    mutable std::atomic<uint32> WriteMutexOwner{ 0 };
+
+    /** Plain CSV output. */
+    TUniquePtr<IFileHandle> File;
+    TUniquePtr<FGameplayEventCSVWriter> Writer;
+
+    /** Compressed output, used instead of File and Writer. */
+    TUniquePtr<FGameplayEventCompressedLogWriter> CompressedWriter;
+
+    /** FPlatformTime::Seconds() when the pending compressed block received its first rows; 0 when empty. */
+    double PendingBlockStartSeconds = 0.0;
+
+    /** Reused between batches so steady-state writing does not allocate. */
+    FString Batch;
+
+    std::atomic<bool> bStopRequested{ false };
+    std::atomic<uint64> NumWritten{ 0 };
+    std::atomic<uint64> NumDropped{ 0 };
+
+    /** Records in compressed blocks that failed to write. */
+    std::atomic<uint64> NumLostInFile{ 0 };
+
+    FDelegateHandle SystemErrorHandle;
+    FEvent* WakeEvent = nullptr;
+    FRunnableThread* Thread = nullptr;
+};
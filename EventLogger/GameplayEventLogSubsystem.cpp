@@ -0,0 +1,73 @@
+#include "GameplayEventLogSubsystem.h"
+#include "GameFramework/Actor.h"
+
+void UGameplayEventLogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UClass* LoggerClass = UGameplayEventLogger::StaticClass();
+    if (!SharedLoggerClass.IsNull())
+    {
+        if (UClass* ConfiguredClass = SharedLoggerClass.LoadSynchronous())
+        {
+            LoggerClass = ConfiguredClass;
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] Shared logger class %s could not be loaded, using defaults."), *SharedLoggerClass.ToString());
+        }
+    }
+
+    // Outered to the world, so GetWorld() on the store gives events logged on it directly a game time
+    UWorld& World = GetWorldRef();
+    SharedLogger = NewObject<UGameplayEventLogger>(&World, LoggerClass, MakeUniqueObjectName(&World, LoggerClass, TEXT("SharedEventStore")));
+
+    // The store keeps the events itself, whatever the class defaults say
+    SharedLogger->bUseSharedEventStore = false;
+    SharedLogger->BeginStorage();
+}
+
+void UGameplayEventLogSubsystem::Deinitialize()
+{
+    if (SharedLogger)
+    {
+        // Handles detach in EndPlay, which runs before the world tears down its subsystems; EndStorage
+        // also waits out any handle still submitting from another thread
+        SharedLogger->EndStorage();
+        SharedLogger = nullptr;
+    }
+
+    Super::Deinitialize();
+}
+
+void UGameplayEventLogSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // The store is not registered with a world, so it cannot tick itself
+    if (SharedLogger)
+    {
+        SharedLogger->DrainPendingEvents();
+        SharedLogger->DispatchSubscriptions();
+    }
+}
+
+TStatId UGameplayEventLogSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplayEventLogSubsystem, STATGROUP_Tickables);
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogSubsystem::GetEventsForOwner(const AActor* Owner) const
+{
+    if (!SharedLogger || !Owner)
+    {
+        return TArray<FGameplayEventEntry>();
+    }
+
+    return SharedLogger->GetEventsByOwner(Owner->GetPathName());
+}
+
+bool UGameplayEventLogSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventLogSubsystem.generated.h"
+
+/**
+ * UGameplayEventLogSubsystem
+ * --------------------------
+ * Per-world owner of the shared event store. Loggers with bUseSharedEventStore forward their
+ * events here instead of keeping their own log, each record tagged with its owning actor, so
+ * the world has a single timeline: global queries and exports are one pass over one log
+ * instead of a merge of one log (and one mutex) per instrumented actor.
+ *
+ * The store is itself a UGameplayEventLogger that is not attached to any actor, so every
+ * query, export, file sink and capacity option works on the global timeline. Its settings
+ * are the defaults of SharedLoggerClass.
+ */
+UCLASS(Config = Game)
+class YOURPROJECT_API UGameplayEventLogSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //~ Begin USubsystem Interface
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    //~ End USubsystem Interface
+
+    //~ Begin FTickableGameObject Interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    //~ End FTickableGameObject Interface
+
+    /** The shared store, for queries and exports over every attached logger. Null outside the subsystem's lifetime. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    UGameplayEventLogger* GetSharedLogger() const { return SharedLogger; }
+
+    /** Returns the events logged by Owner's loggers through the shared store, oldest first. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetEventsForOwner(const AActor* Owner) const;
+
+protected:
+    //~ Begin UWorldSubsystem Interface
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    //~ End UWorldSubsystem Interface
+
+    /** Logger class whose defaults configure the store (capacity, search index, file sink, ...). Empty uses UGameplayEventLogger. */
+    UPROPERTY(Config, EditAnywhere, Category = "Event Logger")
+    TSoftClassPtr<UGameplayEventLogger> SharedLoggerClass;
+
+private:
+    UPROPERTY(Transient)
+    UGameplayEventLogger* SharedLogger = nullptr;
+};
@@ -1,148 +1,1322 @@
 #include "GameplayEventLogger.h"
-#include "Misc/FileHelper.h"
+#include "GameplayEventBinaryLog.h"
+#include "GameplayEventCompressedLog.h"
+#include "GameplayEventLogSubsystem.h"
+#include "GameplayEventCSVWriter.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/Paths.h"
 #include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_STATS_GROUP(TEXT("GameplayEventLogger"), STATGROUP_GameplayEventLogger, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("LogEvent"), STAT_GameplayEventLogger_LogEvent, STATGROUP_GameplayEventLogger);
+DECLARE_CYCLE_STAT(TEXT("Drain Pending Events"), STAT_GameplayEventLogger_Drain, STATGROUP_GameplayEventLogger);
+DECLARE_CYCLE_STAT(TEXT("Export CSV"), STAT_GameplayEventLogger_Export, STATGROUP_GameplayEventLogger);
+DECLARE_CYCLE_STAT(TEXT("Export Binary"), STAT_GameplayEventLogger_ExportBinary, STATGROUP_GameplayEventLogger);
+DECLARE_CYCLE_STAT(TEXT("Export Compressed"), STAT_GameplayEventLogger_ExportCompressed, STATGROUP_GameplayEventLogger);
+DECLARE_CYCLE_STAT(TEXT("Diff Binary Logs"), STAT_GameplayEventLogger_DiffBinary, STATGROUP_GameplayEventLogger);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ring Buffer Overflows"), STAT_GameplayEventLogger_RingOverflows, STATGROUP_GameplayEventLogger);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dropped Events"), STAT_GameplayEventLogger_Dropped, STATGROUP_GameplayEventLogger);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spilled Events"), STAT_GameplayEventLogger_Spilled, STATGROUP_GameplayEventLogger);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sampled Out Events"), STAT_GameplayEventLogger_SampledOut, STATGROUP_GameplayEventLogger);
+
+namespace GameplayEventLoggerPrivate
+{
+    /** Spilling a batch at a time amortizes the file write over many LogEvent calls. */
+    constexpr int32 SpillBatchDivisor = 8;
+
+    /** Records the async echo thread can fall behind by before echoes are skipped. */
+    constexpr uint32 EchoQueueCapacity = 16 * 1024;
+
+    /** Streams every record of View to a CSV file, one storage segment at a time. */
+    bool WriteViewToCSV(const FGameplayEventLogView& View, const FString& FilePath)
+    {
+        FGameplayEventCSVWriter Writer(*View.Strings, View.Clock, &View.Fields);
+        if (!Writer.Open(FilePath))
+        {
+            return false;
+        }
+
+        View.Records.ForEachRun([&Writer](TArrayView<const FGameplayEventRecord> Run)
+        {
+            Writer.Write(Run);
+        });
+        return Writer.Close();
+    }
+
+    /**
+     * Streams every record of View to a binary .gelog file, one storage segment at a time. With
+     * bSequenceOrder the records are written by sequence number instead of storage order, which
+     * can differ by the few events whose threads reached the lock out of turn.
+     */
+    bool WriteViewToBinary(const FGameplayEventLogView& View, const FString& FilePath, bool bSequenceOrder)
+    {
+        FGameplayEventBinaryWriter Writer(*View.Strings, View.Clock);
+        if (!Writer.Open(FilePath))
+        {
+            return false;
+        }
+
+        if (bSequenceOrder)
+        {
+            TArray<FGameplayEventRecord> Ordered;
+            Ordered.Reserve(View.Num());
+            View.Records.ForEachRun([&Ordered](TArrayView<const FGameplayEventRecord> Run)
+            {
+                Ordered.Append(Run.GetData(), Run.Num());
+            });
+
+            Algo::SortBy(Ordered, &FGameplayEventRecord::Sequence);
+            Writer.Write(Ordered);
+            return Writer.Close();
+        }
+
+        View.Records.ForEachRun([&Writer](TArrayView<const FGameplayEventRecord> Run)
+        {
+            Writer.Write(Run);
+        });
+        return Writer.Close();
+    }
+
+    /** Streams every record of View to a block-compressed .gelz file and reports the compression stats. */
+    bool WriteViewToCompressed(const FGameplayEventLogView& View, const FString& FilePath, EGameplayEventCompression Compression, FGameplayEventCompressionStats& OutStats)
+    {
+        FGameplayEventCompressedLogWriter Writer(*View.Strings, View.Clock, Compression, &View.Fields);
+        if (!Writer.Open(FilePath))
+        {
+            return false;
+        }
+
+        View.Records.ForEachRun([&Writer](TArrayView<const FGameplayEventRecord> Run)
+        {
+            Writer.Write(Run);
+        });
+
+        const bool bClosed = Writer.Close();
+        Writer.GetStats(OutStats);
+        return bClosed;
+    }
+}
 
 UGameplayEventLogger::UGameplayEventLogger()
+    : Clock(FGameplayEventClock::CaptureNow())
+    , StringTable(MakeShared<FGameplayEventStringTable, ESPMode::ThreadSafe>())
+    , SchemaNameIds(MakeUnique<std::atomic<int32>[]>(FGameplayEventSchemaRegistry::MaxSchemas))
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Ticking only drains the lock-free buffers and dispatches subscriptions, enabled when needed.
+    // Late in the frame so each drain merges everything logged during that frame.
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
-void UGameplayEventLogger::LogEvent(const FString& EventName, const FString& Context)
+void UGameplayEventLogger::BeginPlay()
 {
-    if (EventName.IsEmpty())
+    Super::BeginPlay();
+
+    UWorld* World = GetWorld();
+    UGameplayEventLogSubsystem* Subsystem = bUseSharedEventStore && World ? World->GetSubsystem<UGameplayEventLogSubsystem>() : nullptr;
+
+    if (Subsystem && Subsystem->GetSharedLogger())
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] LogEvent called with empty EventName."));
-        return;
+        AttachToSharedStore(*Subsystem->GetSharedLogger());
+    }
+    else
+    {
+        if (bUseSharedEventStore)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] %s: no shared event store in this world, storing events locally."), *GetName());
+        }
+        BeginStorage();
     }
 
-    float CurrentGameTime = 0.f;
-    if (GetWorld())
+    // Path names, unlike names, stay distinct across streamed sublevels
+    OwnerId = StringTable->Intern(GetOwner() ? GetOwner()->GetPathName() : FString());
+
+    for (const FGameplayEventSamplingRule& Rule : SamplingRules)
     {
-        CurrentGameTime = GetWorld()->GetTimeSeconds();
+        SetSamplingRule(Rule);
     }
 
-    FGameplayEventEntry NewEntry(EventName, Context, CurrentGameTime);
+    // Kept across EndPlay so aggregates can still be queried afterwards
+    if (bEnableAggregates && !Aggregator)
+    {
+        Aggregator = MakeUnique<FGameplayEventAggregator>(AggregateBucketSeconds, AggregateBucketCount);
+    }
+}
 
+void UGameplayEventLogger::BeginStorage()
+{
     {
         FScopeLock Lock(&Mutex);
-        EventLog.Add(NewEntry);
+        ApplyCapacity_Locked();
+
+        bSearchIndexActive = bEnableSearchIndex;
+        RebuildSearchIndex_Locked();
+    }
+
+    if (bEnableFileSink)
+    {
+        const bool bCompressed = FileSinkCompression != EGameplayEventCompression::None;
+
+        FString Path = FileSinkPath;
+        if (Path.IsEmpty())
+        {
+            // A compressed file is started over, so give each session its own
+            const FString OwnerName = GetOwner() ? GetOwner()->GetName() : TEXT("NoOwner");
+            Path = FPaths::ProjectLogDir() / (bCompressed
+                ? FString::Printf(TEXT("%s_%s_Events_%s.gelz"), *OwnerName, *GetName(), *FDateTime::Now().ToString())
+                : FString::Printf(TEXT("%s_%s_Events.csv"), *OwnerName, *GetName()));
+        }
+
+        FileSink = MakeUnique<FGameplayEventFileSink>(StringTable, Clock, Path, static_cast<uint32>(FMath::Max(FileSinkQueueCapacity, 2)), FileSinkFlushInterval,
+            FileSinkCompression, FMath::Max(FileSinkBlockSizeKB, 4) * 1024, FileSinkMaxBlockSeconds);
+        if (!FileSink->IsOpen())
+        {
+            FileSink.Reset();
+        }
     }
 
 #if WITH_EDITOR
-    UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] Event Logged: '%s' | Context: '%s' | GameTime: %.3f | UTC: %s"),
-        *EventName, *Context, CurrentGameTime, *NewEntry.RealTimestamp.ToString());
+    EchoNameFilter.Reset();
+    for (const FString& Name : EchoEventNames)
+    {
+        if (!Name.IsEmpty())
+        {
+            EchoNameFilter.Add(StringTable->Intern(Name));
+        }
+    }
+
+    if (EchoMode == EGameplayEventEchoMode::Async)
+    {
+        EchoWorker = MakeUnique<FGameplayEventEchoWorker>(StringTable, Clock, GameplayEventLoggerPrivate::EchoQueueCapacity, EchoFlushInterval);
+    }
 #endif
+
+    if (bUseLockFreeBuffer)
+    {
+        if (bUsePerThreadBuffers)
+        {
+            ThreadBuffers = MakeUnique<FGameplayEventThreadBuffers>(static_cast<uint32>(FMath::Max(PerThreadBufferCapacity, 2)));
+        }
+        else
+        {
+            PendingEvents = MakeUnique<TGameplayEventRingBuffer<FGameplayEventPendingRecord>>(static_cast<uint32>(FMath::Max(LockFreeBufferCapacity, 2)));
+        }
+    }
+
+    // Ticking drains the lock-free buffers and dispatches subscriptions
+    if (bUseLockFreeBuffer || Subscriptions.HasAny())
+    {
+        SetComponentTickEnabled(true);
+    }
+
+    bStorageOpen.store(true, std::memory_order_seq_cst);
 }
 
-void UGameplayEventLogger::ClearLog()
+void UGameplayEventLogger::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    FScopeLock Lock(&Mutex);
-    EventLog.Empty();
+    if (SharedStore)
+    {
+        for (const int32 SubscriptionId : ForwardedSubscriptionIds)
+        {
+            SharedStore->Subscriptions.Remove(SubscriptionId);
+        }
+        ForwardedSubscriptionIds.Reset();
+
+        // Events already forwarded stay in the shared store
+        SharedStore = nullptr;
+    }
+    else
+    {
+        EndStorage();
+    }
+
+    SetComponentTickEnabled(false);
+    Super::EndPlay(EndPlayReason);
 }
 
-void UGameplayEventLogger::DumpLogToConsole() const
+void UGameplayEventLogger::EndStorage()
 {
-    FScopeLock Lock(&Mutex);
+    // Handles may be logging on other threads; stop new calls from reaching the members released
+    // below and wait for those already past the flag
+    bStorageOpen.store(false, std::memory_order_seq_cst);
+    while (NumSubmitting.load(std::memory_order_seq_cst) > 0)
+    {
+        FPlatformProcess::YieldThread();
+    }
 
-    UE_LOG(LogTemp, Log, TEXT("---- Gameplay Event Log Dump Start ----"));
-    for (const FGameplayEventEntry& Entry : EventLog)
     {
-        UE_LOG(LogTemp, Log, TEXT("GameTime: %.3f | Event: %s | Context: %s | UTC: %s"),
-            Entry.GameTime, *Entry.EventName, *Entry.Context, *Entry.RealTimestamp.ToString());
+        FScopeLock Lock(&Mutex);
+        DrainPendingEvents_Locked();
+        PendingEvents.Reset();
+        ThreadBuffers.Reset();
+        SpillFile.Reset();
     }
-    UE_LOG(LogTemp, Log, TEXT("---- Gameplay Event Log Dump End ----"));
+
+    // Join the background threads after they flushed what is left
+    FileSink.Reset();
+    EchoWorker.Reset();
 }
 
-bool UGameplayEventLogger::ExportLogToCSV(const FString& FilePath) const
+void UGameplayEventLogger::AttachToSharedStore(UGameplayEventLogger& Store)
+{
+    check(&Store != this);
+
+    SharedStore = &Store;
+    StringTable = Store.StringTable;
+    Clock = Store.Clock;
+
+    // Cached handles point into the table this component had before
+    for (int32 SchemaId = 0; SchemaId < FGameplayEventSchemaRegistry::MaxSchemas; ++SchemaId)
+    {
+        SchemaNameIds[SchemaId].store(FGameplayEventStringTable::EmptyHandle, std::memory_order_relaxed);
+    }
+}
+
+void UGameplayEventLogger::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    DrainPendingEvents();
+    DispatchSubscriptions();
+}
+
+void UGameplayEventLogger::DrainPendingEvents()
 {
     FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+}
+
+void UGameplayEventLogger::DispatchSubscriptions()
+{
+    Subscriptions.Dispatch(*StringTable);
+}
 
-    if (EventLog.Num() == 0)
+void UGameplayEventLogger::LogEvent(const FString& EventName, const FString& Context)
+{
+    if (EventName.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] LogEvent called with empty EventName."));
+        return;
+    }
+
+    const int32 NameId = StringTable->InternCached(EventName);
+    const double GameTime = GetCurrentGameTime();
+    if (AdmitEvent(NameId, GameTime))
+    {
+        LogEventInternal(NameId, FString(Context), GameTime, TArray<FGameplayEventField>());
+    }
+}
+
+void UGameplayEventLogger::LogStructuredEvent(const FString& EventName, FGameplayEventFields Fields, const FString& Context)
+{
+    if (EventName.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] LogStructuredEvent called with empty EventName."));
+        return;
+    }
+
+    const int32 NameId = StringTable->InternCached(EventName);
+    const double GameTime = GetCurrentGameTime();
+    if (AdmitEvent(NameId, GameTime))
+    {
+        LogEventInternal(NameId, FString(Context), GameTime, Fields.Release());
+    }
+}
+
+double UGameplayEventLogger::GetCurrentGameTime() const
+{
+    const UWorld* World = GetWorld();
+    return World ? static_cast<double>(World->GetTimeSeconds()) : 0.0;
+}
+
+bool UGameplayEventLogger::AdmitEvent(int32 NameId, double GameTime)
+{
+    // Aggregates count every event, including those sampled out or not retained
+    if (Aggregator)
+    {
+        Aggregator->Record(NameId, static_cast<float>(GameTime));
+    }
+
+    if (!bRetainRawEvents)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] No events to export."));
         return false;
     }
 
-    FString CSVContent = TEXT("GameTime,EventName,Context,UTC_Timestamp\n");
+    if (!Sampler.HasRules() || Sampler.ShouldKeep(NameId, FGameplayEventClock::ReadCycles()))
+    {
+        return true;
+    }
+
+    INC_DWORD_STAT(STAT_GameplayEventLogger_SampledOut);
+    return false;
+}
 
-    for (const FGameplayEventEntry& Entry : EventLog)
+void UGameplayEventLogger::SetSamplingRule(const FGameplayEventSamplingRule& Rule)
+{
+    if (Rule.EventName.IsEmpty())
     {
-        CSVContent += FString::Printf(
-            TEXT("%.3f,%s,%s,%s\n"),
-            Entry.GameTime,
-            *SanitizeForCSV(Entry.EventName),
-            *SanitizeForCSV(Entry.Context),
-            *Entry.RealTimestamp.ToString()
-        );
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] SetSamplingRule called with empty EventName."));
+        return;
     }
 
-    const bool bSaved = FFileHelper::SaveStringToFile(CSVContent, *FilePath);
+    Sampler.SetRule(StringTable->Intern(Rule.EventName), Rule);
+}
 
-    if (!bSaved)
+void UGameplayEventLogger::RemoveSamplingRule(const FString& EventName)
+{
+    const int32 NameId = StringTable->Find(EventName);
+    if (NameId != INDEX_NONE)
     {
-        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to save CSV to path: %s"), *FilePath);
+        Sampler.RemoveRule(NameId);
     }
+}
 
-    return bSaved;
+int64 UGameplayEventLogger::GetSuppressedEventCount(const FString& EventName) const
+{
+    const int32 NameId = StringTable->Find(EventName);
+    return NameId != INDEX_NONE ? static_cast<int64>(Sampler.GetSuppressedCount(NameId)) : 0;
 }
 
-const TArray<FGameplayEventEntry>& UGameplayEventLogger::GetEventLog() const
+int64 UGameplayEventLogger::GetTotalSuppressedEventCount() const
 {
-    return EventLog;
+    return static_cast<int64>(Sampler.GetTotalSuppressed());
 }
 
-TArray<FGameplayEventEntry> UGameplayEventLogger::SearchEventsByName(const FString& SearchTerm) const
+bool UGameplayEventLogger::GetEventAggregate(const FString& EventName, FGameplayEventAggregate& OutAggregate) const
 {
-    FScopeLock Lock(&Mutex);
+    const int32 NameId = StringTable->Find(EventName);
+    if (!Aggregator || NameId == INDEX_NONE)
+    {
+        return false;
+    }
 
-    TArray<FGameplayEventEntry> Results;
-    const FString SearchTermLower = SearchTerm.ToLower();
+    OutAggregate = FGameplayEventAggregate();
+    OutAggregate.EventName = EventName;
+    return Aggregator->Get(NameId, static_cast<float>(GetCurrentGameTime()), OutAggregate);
+}
+
+TArray<FGameplayEventAggregate> UGameplayEventLogger::GetAllEventAggregates() const
+{
+    TArray<FGameplayEventAggregate> Results;
+    if (!Aggregator)
+    {
+        return Results;
+    }
 
-    for (const FGameplayEventEntry& Entry : EventLog)
+    TArray<int32> NameIds;
+    Aggregator->ForEachName([&NameIds](int32 NameId) { NameIds.Add(NameId); });
+
+    const float Now = static_cast<float>(GetCurrentGameTime());
+    for (const int32 NameId : NameIds)
     {
-        if (Entry.EventName.ToLower().Contains(SearchTermLower))
+        FGameplayEventAggregate Aggregate;
+        Aggregate.EventName = StringTable->Resolve(NameId);
+        if (Aggregator->Get(NameId, Now, Aggregate))
         {
-            Results.Add(Entry);
+            Results.Add(MoveTemp(Aggregate));
         }
     }
 
     return Results;
 }
 
-TArray<FGameplayEventEntry> UGameplayEventLogger::SearchEventsByContext(const FString& SearchTerm) const
+void UGameplayEventLogger::ResetEventAggregates()
+{
+    if (Aggregator)
+    {
+        Aggregator->Reset();
+    }
+}
+
+int32 UGameplayEventLogger::GetSchemaNameId(const FGameplayEventSchemaInfo& Schema)
+{
+    if (Schema.Id == INDEX_NONE)
+    {
+        // Registry overflow: fall back to the runtime path
+        return StringTable->Intern(Schema.Name);
+    }
+
+    std::atomic<int32>& Cached = SchemaNameIds[Schema.Id];
+    int32 NameId = Cached.load(std::memory_order_relaxed);
+    if (NameId == FGameplayEventStringTable::EmptyHandle)
+    {
+        // Racing threads intern the same string and store the same handle
+        NameId = StringTable->Intern(Schema.Name);
+        Cached.store(NameId, std::memory_order_relaxed);
+    }
+    return NameId;
+}
+
+void UGameplayEventLogger::LogEventInternal(int32 NameId, FString&& Context, double GameTime, TArray<FGameplayEventField>&& Fields)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_LogEvent);
+
+    // Handles hand the event over; the shared store numbers, writes, echoes and keeps it
+    UGameplayEventLogger& Target = SharedStore ? *SharedStore : *this;
+
+    FGameplayEventRecord NewRecord;
+    NewRecord.Cycles = FGameplayEventClock::ReadCycles();
+    NewRecord.GameTime = GameTime;
+    NewRecord.NameId = NameId;
+    NewRecord.OwnerId = OwnerId;
+    NewRecord.NumFields = Fields.Num();
+    NewRecord.FrameNumber = static_cast<uint32>(GFrameCounter);
+    NewRecord.Context = MoveTemp(Context);
+
+    if (Target.bReplayCapture)
+    {
+        NewRecord.Sequence = Target.LastSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    Target.SubmitRecord(MoveTemp(NewRecord), MoveTemp(Fields));
+}
+
+void UGameplayEventLogger::SubmitRecord(FGameplayEventRecord&& NewRecord, TArray<FGameplayEventField>&& Fields)
 {
+    // Counted before the flag is read (both sequentially consistent), so EndStorage either waits
+    // for this call or this call sees storage closing
+    NumSubmitting.fetch_add(1, std::memory_order_seq_cst);
+    const bool bQueued = bStorageOpen.load(std::memory_order_seq_cst) && ForwardAndQueue(NewRecord, Fields);
+    NumSubmitting.fetch_sub(1, std::memory_order_seq_cst);
+
+    if (bQueued)
+    {
+        return;
+    }
+
     FScopeLock Lock(&Mutex);
+    // Drain first so an overflowing or late event lands after everything already queued
+    DrainPendingEvents_Locked();
+    StoreRecord_Locked(MoveTemp(NewRecord), Fields);
+}
 
-    TArray<FGameplayEventEntry> Results;
-    const FString SearchTermLower = SearchTerm.ToLower();
+bool UGameplayEventLogger::ForwardAndQueue(FGameplayEventRecord& NewRecord, TArray<FGameplayEventField>& Fields)
+{
+    // Copy out to the sink and echo first: the record and fields are handed over to storage below
+    if (FileSink)
+    {
+        FileSink->Enqueue(NewRecord, Fields);
+    }
 
-    for (const FGameplayEventEntry& Entry : EventLog)
+#if WITH_EDITOR
+    EchoRecord(NewRecord, Fields);
+#endif
+
+    if (PendingEvents || ThreadBuffers)
     {
-        if (Entry.Context.ToLower().Contains(SearchTermLower))
+        FGameplayEventPendingRecord Pending{ MoveTemp(NewRecord), MoveTemp(Fields) };
+        const bool bQueued = ThreadBuffers ? ThreadBuffers->TryEnqueue(MoveTemp(Pending)) : PendingEvents->TryEnqueue(MoveTemp(Pending));
+        if (bQueued)
         {
-            Results.Add(Entry);
+            return true;
         }
+
+        // TryEnqueue leaves the element untouched when the ring is full
+        NewRecord = MoveTemp(Pending.Record);
+        Fields = MoveTemp(Pending.Fields);
+        INC_DWORD_STAT(STAT_GameplayEventLogger_RingOverflows);
     }
 
-    return Results;
+    return false;
 }
 
-int32 UGameplayEventLogger::GetEventCount() const
+void UGameplayEventLogger::EchoRecord(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields)
+{
+    if (EchoMode == EGameplayEventEchoMode::Off)
+    {
+        return;
+    }
+
+    if (EchoNameFilter.Num() > 0 && !EchoNameFilter.Contains(Record.NameId))
+    {
+        return;
+    }
+
+    if (EchoWorker)
+    {
+        EchoWorker->Enqueue(Record, Fields);
+        return;
+    }
+
+    FString RenderedFields;
+    FGameplayEventField::AppendAll(Fields, 0, Fields.Num(), RenderedFields);
+
+    UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] Event Logged: '%s' | Context: '%s' | Fields: '%s' | GameTime: %.3f | UTC: %s"),
+        *StringTable->Resolve(Record.NameId), *Record.Context, *RenderedFields, Record.GameTime, *Clock.ToUtc(Record.Cycles).ToString());
+}
+
+int32 UGameplayEventLogger::SubscribeToEvents(const FGameplayEventSubscriptionFilter& Filter, FGameplayEventBatchReceived OnEvents)
+{
+    // Entries are only materialized for the matched events, once per frame
+    return AddEventSubscription(Filter, [OnEvents, EntryClock = Clock](TArrayView<const FGameplayEventPendingRecord> Events, const FGameplayEventStringTable& Strings)
+    {
+        TArray<FGameplayEventEntry> Entries;
+        Entries.Reserve(Events.Num());
+
+        for (const FGameplayEventPendingRecord& Event : Events)
+        {
+            const FGameplayEventRecord& Record = Event.Record;
+
+            FString RenderedFields;
+            FGameplayEventField::AppendAll(Event.Fields, 0, Event.Fields.Num(), RenderedFields);
+
+            Entries.Emplace(Strings.Resolve(Record.NameId), Record.Context, static_cast<float>(Record.GameTime), EntryClock.ToUtc(Record.Cycles),
+                MoveTemp(RenderedFields), Strings.Resolve(Record.OwnerId));
+        }
+
+        OnEvents.ExecuteIfBound(Entries);
+    });
+}
+
+int32 UGameplayEventLogger::AddEventSubscription(const FGameplayEventSubscriptionFilter& Filter, FGameplayEventSubscriptions::FCallback OnEvents,
+    FGameplayEventSubscriptions::FPredicate Predicate)
+{
+    // Handles subscribe on the shared store, limited to their own events
+    UGameplayEventLogger& Store = SharedStore ? *SharedStore : *this;
+
+    TArray<int32> NameIds;
+    NameIds.Reserve(Filter.EventNames.Num());
+    for (const FString& Name : Filter.EventNames)
+    {
+        if (!Name.IsEmpty())
+        {
+            NameIds.AddUnique(Store.StringTable->Intern(Name));
+        }
+    }
+
+    const int32 SubscriptionId = Store.Subscriptions.Add(MoveTemp(NameIds), Filter.Categories, SharedStore ? OwnerId : INDEX_NONE,
+        MoveTemp(Predicate), MoveTemp(OnEvents));
+
+    if (SharedStore)
+    {
+        ForwardedSubscriptionIds.Add(SubscriptionId);
+    }
+    else if (IsRegistered())
+    {
+        // Dispatch runs from the tick
+        SetComponentTickEnabled(true);
+    }
+
+    return SubscriptionId;
+}
+
+void UGameplayEventLogger::Unsubscribe(int32 SubscriptionId)
+{
+    if (SharedStore && ForwardedSubscriptionIds.Remove(SubscriptionId) > 0)
+    {
+        SharedStore->Subscriptions.Remove(SubscriptionId);
+        return;
+    }
+
+    Subscriptions.Remove(SubscriptionId);
+}
+
+void UGameplayEventLogger::ClearLog()
 {
     FScopeLock Lock(&Mutex);
-    return EventLog.Num();
+    DrainPendingEvents_Locked();
+    EventLog.Reset();
+    FieldLog.Reset();
+    SearchIndex.ResetPostings();
 }
 
-FString UGameplayEventLogger::SanitizeForCSV(const FString& Input) const
+void UGameplayEventLogger::DumpLogToConsole() const
 {
-    FString Output = Input;
-    // Escape double quotes by doubling them, and wrap in quotes if contains commas or quotes
-    if (Output.Contains(TEXT("\"")) || Output.Contains(TEXT(",")))
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    UE_LOG(LogTemp, Log, TEXT("---- Gameplay Event Log Dump Start ----"));
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        UE_LOG(LogTemp, Log, TEXT("GameTime: %.3f | Owner: %s | Event: %s | Context: %s | Fields: %s | UTC: %s"),
+            Record.GameTime, *StringTable->Resolve(Record.OwnerId), *StringTable->Resolve(Record.NameId), *Record.Context,
+            *RenderFields_Locked(Record), *Clock.ToUtc(Record.Cycles).ToString());
+    }
+
+    Sampler.ForEachRule([this](int32 NameId, uint64 NumSeen, uint64 NumSuppressed)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Sampled: %s | Seen: %llu | Suppressed: %llu"), *StringTable->Resolve(NameId), NumSeen, NumSuppressed);
+    });
+    UE_LOG(LogTemp, Log, TEXT("---- Gameplay Event Log Dump End ----"));
+}
+
+bool UGameplayEventLogger::ExportLogToCSV(const FString& FilePath) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_Export);
+
+    // Only taking the view happens under Mutex; formatting and disk I/O run unlocked
+    const FGameplayEventLogView View = GetEventLogView();
+    if (View.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] No events to export."));
+        return false;
+    }
+
+    const bool bSaved = GameplayEventLoggerPrivate::WriteViewToCSV(View, FilePath);
+
+    if (!bSaved)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to save CSV to path: %s"), *FilePath);
+    }
+
+    return bSaved;
+}
+
+void UGameplayEventLogger::ExportLogToCSVAsync(const FString& FilePath, FGameplayEventExportComplete OnComplete) const
+{
+    FGameplayEventLogView View = GetEventLogView();
+    if (View.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] No events to export."));
+        OnComplete.ExecuteIfBound(false, FilePath);
+        return;
+    }
+
+    Async(EAsyncExecution::ThreadPool, [FilePath, View = MoveTemp(View), OnComplete]()
+    {
+        const bool bSaved = GameplayEventLoggerPrivate::WriteViewToCSV(View, FilePath);
+
+        if (!bSaved)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to save CSV to path: %s"), *FilePath);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [OnComplete, bSaved, FilePath]()
+        {
+            OnComplete.ExecuteIfBound(bSaved, FilePath);
+        });
+    });
+}
+
+bool UGameplayEventLogger::ExportLogToBinary(const FString& FilePath) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_ExportBinary);
+
+    const FGameplayEventLogView View = GetEventLogView();
+    if (View.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] No events to export."));
+        return false;
+    }
+
+    const bool bSaved = GameplayEventLoggerPrivate::WriteViewToBinary(View, FilePath, bReplayCapture);
+
+    if (!bSaved)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to save binary log to path: %s"), *FilePath);
+    }
+
+    return bSaved;
+}
+
+bool UGameplayEventLogger::ExportLogToCompressed(const FString& FilePath, EGameplayEventCompression Compression) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_ExportCompressed);
+
+    const FGameplayEventLogView View = GetEventLogView();
+    if (View.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] No events to export."));
+        return false;
+    }
+
+    FGameplayEventCompressionStats Stats;
+    const bool bSaved = GameplayEventLoggerPrivate::WriteViewToCompressed(View, FilePath, Compression, Stats);
+
+    if (!bSaved)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to save compressed log to path: %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] Compressed %d events in %d blocks: %.2f MB -> %.2f MB (%.1fx), %.2f ms CPU per MB"),
+        View.Num(), Stats.NumBlocks, Stats.UncompressedBytes / (1024.0 * 1024.0), Stats.CompressedBytes / (1024.0 * 1024.0),
+        Stats.CompressionRatio, Stats.CompressMillisecondsPerMB);
+    return true;
+}
+
+void UGameplayEventLogger::FlushFileSink()
+{
+    if (FileSink)
+    {
+        FileSink->Flush();
+    }
+}
+
+int64 UGameplayEventLogger::GetFileSinkDroppedEventCount() const
+{
+    return FileSink ? static_cast<int64>(FileSink->GetNumDropped()) : 0;
+}
+
+bool UGameplayEventLogger::GetFileSinkCompressionStats(FGameplayEventCompressionStats& OutStats) const
+{
+    return FileSink && FileSink->GetCompressionStats(OutStats);
+}
+
+bool UGameplayEventLogger::ConvertBinaryLogToCSV(const FString& BinaryPath, const FString& CSVPath)
+{
+    const bool bConverted = FGameplayEventBinaryReader::ConvertToCSV(BinaryPath, CSVPath);
+
+    if (!bConverted)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to convert %s to CSV at %s"), *BinaryPath, *CSVPath);
+    }
+
+    return bConverted;
+}
+
+bool UGameplayEventLogger::DiffBinaryLogs(const FString& BinaryPathA, const FString& BinaryPathB, FGameplayEventLogDivergence& OutDivergence, float GameTimeTolerance)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_DiffBinary);
+
+    OutDivergence = FGameplayEventLogDivergence();
+    if (!FGameplayEventBinaryReader::FindFirstDivergence(BinaryPathA, BinaryPathB, GameTimeTolerance, OutDivergence))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to diff %s against %s"), *BinaryPathA, *BinaryPathB);
+        return false;
+    }
+
+    if (OutDivergence.bDiverged)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] Logs diverge after %lld matching events (%s): A[%lld] %s | B[%lld] %s"),
+            OutDivergence.NumMatched, *OutDivergence.Reason, OutDivergence.IndexA, *OutDivergence.EventA, OutDivergence.IndexB, *OutDivergence.EventB);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Log, TEXT("[GameplayEventLogger] Logs match over %lld events."), OutDivergence.NumMatched);
+    }
+
+    return true;
+}
+
+bool UGameplayEventLogger::ConvertCompressedLogToCSV(const FString& CompressedPath, const FString& CSVPath, float MinGameTime, float MaxGameTime)
+{
+    const bool bConverted = FGameplayEventCompressedLogReader::ConvertToCSV(CompressedPath, CSVPath, MinGameTime, MaxGameTime);
+
+    if (!bConverted)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to convert %s to CSV at %s"), *CompressedPath, *CSVPath);
+    }
+
+    return bConverted;
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::GetEventLog() const
+{
+    // Materialize outside the lock; the view keeps the records stable meanwhile
+    const FGameplayEventLogView View = GetEventLogView();
+
+    TArray<FGameplayEventEntry> Results;
+    Results.Reserve(View.Num());
+
+    for (int32 Index = 0; Index < View.Num(); ++Index)
+    {
+        Results.Add(View.MakeEntry(Index));
+    }
+
+    return Results;
+}
+
+FGameplayEventLogView UGameplayEventLogger::GetEventLogView() const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    FGameplayEventLogView View;
+    View.Records = EventLog.MakeSnapshot();
+    View.Fields = FieldLog.MakeSnapshot();
+    View.Strings = StringTable;
+    View.Clock = Clock;
+    return View;
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::SearchEventsByName(const FString& SearchTerm) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    return SearchEvents_Locked(SearchTerm, EGameplayEventSearchField::Name);
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::SearchEventsByContext(const FString& SearchTerm) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    return SearchEvents_Locked(SearchTerm, EGameplayEventSearchField::Context);
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::GetEventsInGameTimeRange(float StartTime, float EndTime, int32& OutTotalInRange, int32 PageStart, int32 PageSize) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    int32 First = 0;
+    int32 Last = 0;
+    FindRange_Locked(static_cast<double>(StartTime), static_cast<double>(EndTime), [](const FGameplayEventRecord& Record) { return Record.GameTime; }, First, Last);
+
+    OutTotalInRange = Last - First;
+    return MakePage_Locked(First, Last, PageStart, PageSize);
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::GetEventsInUtcRange(const FDateTime& Start, const FDateTime& End, int32& OutTotalInRange, int32 PageStart, int32 PageSize) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    int32 First = 0;
+    int32 Last = 0;
+    // Cycles increase with wall-clock time, so the UTC bounds become cycle bounds on the same ordering
+    FindRange_Locked(Clock.FromUtcTicks(Start.GetTicks()), Clock.FromUtcTicks(End.GetTicks()), [](const FGameplayEventRecord& Record) { return Record.Cycles; }, First, Last);
+
+    OutTotalInRange = Last - First;
+    return MakePage_Locked(First, Last, PageStart, PageSize);
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::GetRecentEvents(float Seconds) const
+{
+    const float Now = static_cast<float>(GetCurrentGameTime());
+
+    int32 TotalInRange = 0;
+    return GetEventsInGameTimeRange(Now - FMath::Max(Seconds, 0.f), TNumericLimits<float>::Max(), TotalInRange);
+}
+
+int32 UGameplayEventLogger::VisitEventsInGameTimeRange(float StartTime, float EndTime, TFunctionRef<void(const FGameplayEventRecord& Record, const FGameplayEventStringTable& Strings)> Visitor) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    int32 First = 0;
+    int32 Last = 0;
+    FindRange_Locked(static_cast<double>(StartTime), static_cast<double>(EndTime), [](const FGameplayEventRecord& Record) { return Record.GameTime; }, First, Last);
+
+    for (int32 Index = First; Index < Last; ++Index)
+    {
+        Visitor(EventLog[Index], *StringTable);
+    }
+
+    return Last - First;
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::FilterEventsByField(FName FieldKey, TFunctionRef<bool(const FGameplayEventField& Field)> Predicate) const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    TArray<FGameplayEventEntry> Results;
+
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        const int32 FirstField = FieldLog.IndexOfId(Record.FirstFieldId);
+        for (int32 FieldIndex = 0; FieldIndex < Record.NumFields; ++FieldIndex)
+        {
+            const FGameplayEventField& Field = FieldLog[FirstField + FieldIndex];
+            if (Field.Key == FieldKey && Predicate(Field))
+            {
+                Results.Add(MakeEntry(Record));
+                break;
+            }
+        }
+    }
+
+    return Results;
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::GetEventsByOwner(const FString& OwnerName) const
+{
+    TArray<FGameplayEventEntry> Results;
+
+    // Handle comparison only; an owner that never logged was never interned
+    const int32 OwnerHandle = StringTable->Find(OwnerName);
+    if (OwnerHandle == INDEX_NONE)
+    {
+        return Results;
+    }
+
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        if (Record.OwnerId == OwnerHandle)
+        {
+            Results.Add(MakeEntry(Record));
+        }
+    }
+
+    return Results;
+}
+
+int32 UGameplayEventLogger::GetEventCount() const
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+    return EventLog.Num();
+}
+
+void UGameplayEventLogger::SetLogCapacity(int32 NewMaxEvents, EGameplayEventOverflowPolicy NewPolicy)
+{
+    FScopeLock Lock(&Mutex);
+    DrainPendingEvents_Locked();
+
+    MaxEvents = FMath::Max(NewMaxEvents, 0);
+    OverflowPolicy = NewPolicy;
+    ApplyCapacity_Locked();
+}
+
+int64 UGameplayEventLogger::GetDroppedEventCount() const
+{
+    FScopeLock Lock(&Mutex);
+    return DroppedEventCount;
+}
+
+int64 UGameplayEventLogger::GetSpilledEventCount() const
+{
+    FScopeLock Lock(&Mutex);
+    return SpilledEventCount;
+}
+
+int64 UGameplayEventLogger::GetLogMemoryBytes() const
+{
+    FScopeLock Lock(&Mutex);
+
+    // Contexts live on the heap beside their records, so they are summed one by one
+    SIZE_T ContextBytes = 0;
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        ContextBytes += Record.Context.GetAllocatedSize();
+    }
+
+    return static_cast<int64>(EventLog.GetAllocatedSize() + FieldLog.GetAllocatedSize() + ContextBytes + StringTable->GetAllocatedSize() + SearchIndex.GetAllocatedSize());
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::SearchEvents_Locked(const FString& SearchTerm, EGameplayEventSearchField Field) const
+{
+    TArray<FGameplayEventEntry> Results;
+
+    if (bSearchIndexActive)
+    {
+        TArray<uint64> RecordIds;
+        SearchIndex.Query(SearchTerm, Field, RecordIds);
+
+        Results.Reserve(RecordIds.Num());
+        for (const uint64 RecordId : RecordIds)
+        {
+            const int32 Index = EventLog.IndexOfId(RecordId);
+            if (Index != INDEX_NONE)
+            {
+                Results.Add(MakeEntry(EventLog[Index]));
+            }
+        }
+
+        return Results;
+    }
+
+    // No index before BeginPlay or when disabled: fall back to a scan
+    if (Field == EGameplayEventSearchField::Context)
+    {
+        for (const FGameplayEventRecord& Record : EventLog)
+        {
+            if (Record.Context.Contains(SearchTerm, ESearchCase::IgnoreCase))
+            {
+                Results.Add(MakeEntry(Record));
+            }
+        }
+        return Results;
+    }
+
+    // Each distinct name is tested once, no matter how many records share it
+    const int32 NumStrings = StringTable->Num();
+    TBitArray<> Tested(false, NumStrings);
+    TBitArray<> Matched(false, NumStrings);
+
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        const int32 Handle = Record.NameId;
+        if (!Tested.IsValidIndex(Handle))
+        {
+            continue;
+        }
+
+        if (!Tested[Handle])
+        {
+            Tested[Handle] = true;
+            Matched[Handle] = StringTable->Resolve(Handle).Contains(SearchTerm, ESearchCase::IgnoreCase);
+        }
+
+        if (Matched[Handle])
+        {
+            Results.Add(MakeEntry(Record));
+        }
+    }
+
+    return Results;
+}
+
+template <typename KeyType, typename ProjectionType>
+void UGameplayEventLogger::FindRange_Locked(KeyType Min, KeyType Max, ProjectionType Projection, int32& OutFirst, int32& OutLast) const
+{
+    // Records are appended in time order, so both bounds are classic lower/upper bound searches
+    auto LowerBound = [this, &Projection](auto&& IsBefore)
+    {
+        int32 Low = 0;
+        int32 High = EventLog.Num();
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (IsBefore(Projection(EventLog[Mid])))
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        return Low;
+    };
+
+    OutFirst = LowerBound([Min](KeyType Key) { return Key < Min; });
+    OutLast = FMath::Max(OutFirst, LowerBound([Max](KeyType Key) { return !(Max < Key); }));
+}
+
+TArray<FGameplayEventEntry> UGameplayEventLogger::MakePage_Locked(int32 First, int32 Last, int32 PageStart, int32 PageSize) const
+{
+    First = FMath::Min(First + FMath::Max(PageStart, 0), Last);
+    if (PageSize > 0)
+    {
+        Last = FMath::Min(Last, First + PageSize);
+    }
+
+    TArray<FGameplayEventEntry> Results;
+    Results.Reserve(Last - First);
+
+    for (int32 Index = First; Index < Last; ++Index)
+    {
+        Results.Add(MakeEntry(EventLog[Index]));
+    }
+
+    return Results;
+}
+
+FGameplayEventEntry UGameplayEventLogger::MakeEntry(const FGameplayEventRecord& Record) const
+{
+    return FGameplayEventEntry(StringTable->Resolve(Record.NameId), Record.Context, static_cast<float>(Record.GameTime), Clock.ToUtc(Record.Cycles), RenderFields_Locked(Record),
+        StringTable->Resolve(Record.OwnerId));
+}
+
+FString UGameplayEventLogger::RenderFields_Locked(const FGameplayEventRecord& Record) const
+{
+    FString Rendered;
+    if (Record.NumFields > 0)
+    {
+        FGameplayEventField::AppendAll(FieldLog, FieldLog.IndexOfId(Record.FirstFieldId), Record.NumFields, Rendered);
+    }
+    return Rendered;
+}
+
+void UGameplayEventLogger::DrainPendingEvents_Locked() const
+{
+    if (!PendingEvents && !ThreadBuffers)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_GameplayEventLogger_Drain);
+
+    // Draining only moves already-logged events into storage, so it is allowed from const queries
+    UGameplayEventLogger* MutableThis = const_cast<UGameplayEventLogger*>(this);
+    auto Store = [MutableThis](FGameplayEventPendingRecord&& Pending)
+    {
+        MutableThis->StoreRecord_Locked(MoveTemp(Pending.Record), Pending.Fields);
+    };
+
+    if (ThreadBuffers)
+    {
+        MutableThis->EventLog.Reserve(ThreadBuffers->GetApproximateNum());
+        MutableThis->ThreadBuffers->DrainMerged(Store);
+        return;
+    }
+
+    MutableThis->EventLog.Reserve(PendingEvents->GetApproximateNum());
+    PendingEvents->Drain(Store);
+}
+
+void UGameplayEventLogger::StoreRecord_Locked(FGameplayEventRecord&& Record, TArrayView<const FGameplayEventField> Fields)
+{
+    auto Append = [this, &Record, Fields]()
+    {
+        Record.NumFields = Fields.Num();
+        Record.FirstFieldId = FieldLog.GetNextId();
+
+        for (const FGameplayEventField& Field : Fields)
+        {
+            FieldLog.Add(Field);
+        }
+
+        // Moved in, so the context is not copied again
+        EventLog.Add(MoveTemp(Record));
+        const FGameplayEventRecord& Stored = EventLog[EventLog.Num() - 1];
+        IndexRecord_Locked(Stored);
+        Subscriptions.Match(Stored, Fields, *StringTable);
+    };
+
+    if (!EventLog.IsFull())
+    {
+        Append();
+        return;
+    }
+
+    if (OverflowPolicy == EGameplayEventOverflowPolicy::DropNewest)
+    {
+        ++DroppedEventCount;
+        INC_DWORD_STAT(STAT_GameplayEventLogger_Dropped);
+        return;
+    }
+
+    if (OverflowPolicy == EGameplayEventOverflowPolicy::SpillOldestToDisk && SpillFile)
+    {
+        SpillOldest_Locked(FMath::Max(EventLog.GetCapacity() / GameplayEventLoggerPrivate::SpillBatchDivisor, 1));
+    }
+    else
+    {
+        // OverwriteOldest, or spilling without a usable spill file
+        UnindexOldest_Locked(1);
+        EventLog.PopOldest(1);
+        ++DroppedEventCount;
+        INC_DWORD_STAT(STAT_GameplayEventLogger_Dropped);
+    }
+
+    TrimFields_Locked();
+    Append();
+}
+
+void UGameplayEventLogger::TrimFields_Locked()
+{
+    // Fields are appended in record order, so everything before the oldest record's first field is orphaned
+    const uint64 FirstLiveFieldId = EventLog.Num() > 0 ? EventLog[0].FirstFieldId : FieldLog.GetNextId();
+    FieldLog.PopOldest(static_cast<int32>(FirstLiveFieldId - FieldLog.GetFirstId()));
+}
+
+void UGameplayEventLogger::IndexRecord_Locked(const FGameplayEventRecord& Record)
+{
+    if (bSearchIndexActive)
+    {
+        SearchIndex.Add(Record, EventLog.GetNextId() - 1, *StringTable);
+    }
+}
+
+void UGameplayEventLogger::UnindexOldest_Locked(int32 NumRecords)
+{
+    if (!bSearchIndexActive)
+    {
+        return;
+    }
+
+    NumRecords = FMath::Min(NumRecords, EventLog.Num());
+    for (int32 Index = 0; Index < NumRecords; ++Index)
+    {
+        SearchIndex.Remove(EventLog[Index], EventLog.GetFirstId() + Index);
+    }
+}
+
+void UGameplayEventLogger::RebuildSearchIndex_Locked()
+{
+    SearchIndex.Reset();
+
+    if (!bSearchIndexActive)
+    {
+        return;
+    }
+
+    uint64 RecordId = EventLog.GetFirstId();
+    for (const FGameplayEventRecord& Record : EventLog)
+    {
+        SearchIndex.Add(Record, RecordId++, *StringTable);
+    }
+}
+
+void UGameplayEventLogger::SpillOldest_Locked(int32 NumToSpill)
+{
+    // The snapshot only references field segments; the fields are trimmed by the caller afterwards
+    const FGameplayEventFieldSnapshot Fields = FieldLog.MakeSnapshot();
+
+    FString SpillContent;
+    FGameplayEventCSVWriter Writer(*StringTable, Clock, &Fields);
+
+    UnindexOldest_Locked(NumToSpill);
+    const int32 NumSpilled = EventLog.PopOldest(NumToSpill, [&Writer, &SpillContent](const FGameplayEventRecord& Record)
+    {
+        Writer.AppendRow(Record, SpillContent);
+    });
+
+    const FTCHARToUTF8 Converted(*SpillContent);
+    if (!SpillFile->Write(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to write %d events to spill file, they are lost."), NumSpilled);
+        DroppedEventCount += NumSpilled;
+        INC_DWORD_STAT_BY(STAT_GameplayEventLogger_Dropped, NumSpilled);
+        return;
+    }
+
+    SpilledEventCount += NumSpilled;
+    INC_DWORD_STAT_BY(STAT_GameplayEventLogger_Spilled, NumSpilled);
+}
+
+void UGameplayEventLogger::ApplyCapacity_Locked()
+{
+    if (MaxEvents > 0)
+    {
+        UnindexOldest_Locked(EventLog.Num() - MaxEvents);
+    }
+
+    const int32 NumDiscarded = EventLog.SetCapacity(MaxEvents);
+    TrimFields_Locked();
+    if (NumDiscarded > 0)
+    {
+        DroppedEventCount += NumDiscarded;
+        INC_DWORD_STAT_BY(STAT_GameplayEventLogger_Dropped, NumDiscarded);
+    }
+
+    const bool bWantsSpillFile = MaxEvents > 0 && OverflowPolicy == EGameplayEventOverflowPolicy::SpillOldestToDisk;
+    if (!bWantsSpillFile)
+    {
+        SpillFile.Reset();
+        return;
+    }
+
+    if (SpillFile)
+    {
+        return;
+    }
+
+    FString Path = SpillFilePath;
+    if (Path.IsEmpty())
+    {
+        const FString OwnerName = GetOwner() ? GetOwner()->GetName() : TEXT("NoOwner");
+        Path = FPaths::ProjectLogDir() / FString::Printf(TEXT("%s_%s_Spill.csv"), *OwnerName, *GetName());
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+    const bool bWriteHeader = !PlatformFile.FileExists(*Path);
+    SpillFile.Reset(PlatformFile.OpenWrite(*Path, /*bAppend=*/ true));
+
+    if (!SpillFile)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[GameplayEventLogger] Failed to open spill file: %s. Overflow will overwrite oldest events."), *Path);
+        return;
+    }
+
+    if (bWriteHeader)
     {
-        Output.ReplaceInline(TEXT("\""), TEXT("\"\""));
-        Output = FString::Printf(TEXT("\"%s\""), *Output);
+        const FTCHARToUTF8 Header(FGameplayEventCSVWriter::Header);
+        SpillFile->Write(reinterpret_cast<const uint8*>(Header.Get()), Header.Length());
     }
-    return Output;
 }
@@ -2,8 +2,221 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "GameplayEventAggregator.h"
+#include "GameplayEventClock.h"
+#include "GameplayEventEchoWorker.h"
+#include "GameplayEventFields.h"
+#include "GameplayEventFileSink.h"
+#include "GameplayEventRingBuffer.h"
+#include "GameplayEventSampler.h"
+#include "GameplayEventSchema.h"
+#include "GameplayEventSearchIndex.h"
+#include "GameplayEventSegmentedLog.h"
+#include "GameplayEventStringTable.h"
+#include "GameplayEventSubscriptions.h"
+#include "GameplayEventThreadBuffers.h"
+#include <atomic>
 #include "GameplayEventLogger.generated.h"
 
+/** What UGameplayEventLogger does with a new event once its bounded log is full. */
+UENUM(BlueprintType)
+enum class EGameplayEventOverflowPolicy : uint8
+{
+    /** Discard the oldest event to make room. */
+    OverwriteOldest,
+
+    /** Keep the existing log and discard the new event. */
+    DropNewest,
+
+    /** Append the oldest events to a spill CSV file, then reuse their slots. */
+    SpillOldestToDisk
+};
+
+/** How LogEvent echoes events to the output log in editor builds. */
+UENUM(BlueprintType)
+enum class EGameplayEventEchoMode : uint8
+{
+    /** No echo. */
+    Off,
+
+    /** Format and UE_LOG on the logging thread (original behavior). */
+    Immediate,
+
+    /** Hand the record to a background thread that formats and logs in batches. */
+    Async
+};
+
+/** How a sampling rule thins out one event name. */
+UENUM(BlueprintType)
+enum class EGameplayEventSamplingMode : uint8
+{
+    /** Keep every event; counts only. */
+    KeepAll,
+
+    /** Keep one event out of every Count. */
+    OneInN,
+
+    /** Keep at most RatePerSecond events per second on average, with bursts of up to BurstSize. */
+    TokenBucket,
+
+    /** Keep the first Count events of every WindowSeconds window. */
+    FirstNPerWindow
+};
+
+/** Block codec for compressed event logs. Values are stored in .gelz files; only append new ones. */
+UENUM(BlueprintType)
+enum class EGameplayEventCompression : uint8
+{
+    /** Blocks are stored raw, still indexed by time. */
+    None,
+
+    Zlib,
+
+    /** Best ratio for its speed; requires the Oodle compression plugin. */
+    Oodle,
+
+    /** Fastest, lowest ratio. */
+    LZ4
+};
+
+/** Sampling rule for one event name, see UGameplayEventLogger::SetSamplingRule. */
+USTRUCT(BlueprintType)
+struct FGameplayEventSamplingRule
+{
+    GENERATED_BODY()
+
+    /** Exact event name the rule applies to. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling")
+    FString EventName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling")
+    EGameplayEventSamplingMode Mode = EGameplayEventSamplingMode::OneInN;
+
+    /** OneInN: keep one event in Count. FirstNPerWindow: events kept per window. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling", meta = (ClampMin = "1"))
+    int32 Count = 10;
+
+    /** TokenBucket: sustained events kept per second. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling", meta = (ClampMin = "0.001"))
+    float RatePerSecond = 10.f;
+
+    /** TokenBucket: events that may be kept back to back before the rate applies. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling", meta = (ClampMin = "1"))
+    int32 BurstSize = 10;
+
+    /** FirstNPerWindow: window length in real-time seconds. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling", meta = (ClampMin = "0.001"))
+    float WindowSeconds = 1.f;
+};
+
+/** Rolling counters for one event name, see UGameplayEventLogger::GetEventAggregate. */
+USTRUCT(BlueprintType)
+struct FGameplayEventAggregate
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    FString EventName;
+
+    /** Events logged under this name since aggregation started, including sampled-out ones. */
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    int64 TotalCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    float FirstSeenGameTime = 0.f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    float LastSeenGameTime = 0.f;
+
+    /** Events per bucket, oldest first. The last bucket contains the current game time. */
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    TArray<int32> BucketCounts;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    float BucketSeconds = 0.f;
+
+    /** Average events per second over the buckets since the name was first seen. */
+    UPROPERTY(BlueprintReadOnly, Category = "Aggregate")
+    float RatePerSecond = 0.f;
+};
+
+/** Result of block compression, see UGameplayEventLogger::GetFileSinkCompressionStats. */
+USTRUCT(BlueprintType)
+struct FGameplayEventCompressionStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Compression")
+    int32 NumBlocks = 0;
+
+    /** UTF-8 CSV bytes fed to the codec. */
+    UPROPERTY(BlueprintReadOnly, Category = "Compression")
+    int64 UncompressedBytes = 0;
+
+    /** Bytes written for the blocks, including block headers. */
+    UPROPERTY(BlueprintReadOnly, Category = "Compression")
+    int64 CompressedBytes = 0;
+
+    /** UncompressedBytes / CompressedBytes. */
+    UPROPERTY(BlueprintReadOnly, Category = "Compression")
+    float CompressionRatio = 0.f;
+
+    /** CPU time spent in the codec per MB of CSV. */
+    UPROPERTY(BlueprintReadOnly, Category = "Compression")
+    float CompressMillisecondsPerMB = 0.f;
+};
+
+/** Which events a subscription receives, see UGameplayEventLogger::SubscribeToEvents. Both lists empty receives every event. */
+USTRUCT(BlueprintType)
+struct FGameplayEventSubscriptionFilter
+{
+    GENERATED_BODY()
+
+    /** Exact event names. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Subscription")
+    TArray<FString> EventNames;
+
+    /** Categories of event types declared with DECLARE_GAMEPLAY_EVENT. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Subscription")
+    TArray<FName> Categories;
+};
+
+/** First point where two binary logs disagree, see UGameplayEventLogger::DiffBinaryLogs. */
+USTRUCT(BlueprintType)
+struct FGameplayEventLogDivergence
+{
+    GENERATED_BODY()
+
+    /** False when the aligned parts of both logs are identical. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    bool bDiverged = false;
+
+    /** Record index of the divergence in the first log; its length if that log ended first. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    int64 IndexA = 0;
+
+    /** Record index of the divergence in the second log; its length if that log ended first. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    int64 IndexB = 0;
+
+    /** Events that matched between the alignment point and the divergence. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    int64 NumMatched = 0;
+
+    /** Which property differed first: sequence, frame, game time, name, context, owner or length. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    FString Reason;
+
+    /** The diverging event of the first log, formatted for display. Empty if that log ended. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    FString EventA;
+
+    /** The diverging event of the second log, formatted for display. Empty if that log ended. */
+    UPROPERTY(BlueprintReadOnly, Category = "Replay")
+    FString EventB;
+};
+
 USTRUCT(BlueprintType)
 struct FGameplayEventEntry
 {
@@ -21,10 +234,138 @@ struct FGameplayEventEntry
     UPROPERTY(BlueprintReadOnly, Category = "Event")
     FDateTime RealTimestamp;
 
+    /** Typed fields rendered as "Key=Value" pairs separated by ';'. Empty for events logged without fields. */
+    UPROPERTY(BlueprintReadOnly, Category = "Event")
+    FString Fields;
+
+    /** Path name of the actor whose logger recorded the event, unique across streamed levels. */
+    UPROPERTY(BlueprintReadOnly, Category = "Event")
+    FString Owner;
+
     FGameplayEventEntry() {}
 
     FGameplayEventEntry(const FString& InName, const FString& InContext, float InGameTime)
         : EventName(InName), Context(InContext), GameTime(InGameTime), RealTimestamp(FDateTime::UtcNow()) {}
+
+    FGameplayEventEntry(const FString& InName, const FString& InContext, float InGameTime, const FDateTime& InRealTimestamp, FString InFields = FString(), const FString& InOwner = FString())
+        : EventName(InName), Context(InContext), GameTime(InGameTime), RealTimestamp(InRealTimestamp), Fields(MoveTemp(InFields)), Owner(InOwner) {}
+};
+
+/** Fired on the game thread once per frame with the events a subscription matched since the previous frame. */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FGameplayEventBatchReceived, const TArray<FGameplayEventEntry>&, Events);
+
+/** Fired on the game thread when an asynchronous export finishes. */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FGameplayEventExportComplete, bool, bSuccess, const FString&, FilePath);
+
+/**
+ * FGameplayEventRecord
+ * --------------------
+ * Compact storage form of a logged event. Name and owner are handles into the
+ * logger's string table; FGameplayEventEntry is only built when Blueprint or an
+ * exporter asks for it.
+ *
+ * The context is usually unique per event, so it travels with the record instead of being
+ * interned: logging threads never touch the string table for it, and its memory goes away
+ * with the record.
+ */
+struct FGameplayEventRecord
+{
+    /** FPlatformTime::Cycles64() when logged. Convert with the owning logger's FGameplayEventClock. */
+    uint64 Cycles = 0;
+
+    /** Position in the store's total order of events, from 1. 0 unless bReplayCapture was set. */
+    uint64 Sequence = 0;
+
+    double GameTime = 0.0;
+
+    int32 NameId = FGameplayEventStringTable::EmptyHandle;
+
+    /** Name of the logging component's owner, so a store shared by many loggers keeps them apart. */
+    int32 OwnerId = FGameplayEventStringTable::EmptyHandle;
+
+    /** Number of typed fields owned by this record. */
+    int32 NumFields = 0;
+
+    /** Low 32 bits of GFrameCounter when logged. */
+    uint32 FrameNumber = 0;
+
+    /** Stable id of the first field in the logger's field storage; the rest follow contiguously. */
+    uint64 FirstFieldId = 0;
+
+    FString Context;
+};
+
+/** A record on its way into storage, together with the fields it still owns. */
+struct FGameplayEventPendingRecord
+{
+    FGameplayEventRecord Record;
+    TArray<FGameplayEventField> Fields;
+};
+
+using FGameplayEventRecordSnapshot = TGameplayEventLogSnapshot<FGameplayEventRecord>;
+
+/**
+ * FGameplayEventLogView
+ * ---------------------
+ * Consistent, zero-copy view of a logger's events at the time it was taken.
+ * Shares the logger's sealed storage segments and string table, so it can be read from
+ * any thread without locking and stays valid after the logger appends, clears or is destroyed.
+ */
+struct FGameplayEventLogView
+{
+    FGameplayEventRecordSnapshot Records;
+
+    /** Typed fields of Records, addressed by FGameplayEventRecord::FirstFieldId. */
+    FGameplayEventFieldSnapshot Fields;
+
+    TSharedPtr<const FGameplayEventStringTable, ESPMode::ThreadSafe> Strings;
+
+    /** Converts record cycle counts to UTC. */
+    FGameplayEventClock Clock;
+
+    int32 Num() const { return Records.Num(); }
+
+    const FGameplayEventRecord& operator[](int32 Index) const { return Records[Index]; }
+
+    const FString& ResolveString(int32 Handle) const { return Strings->Resolve(Handle); }
+
+    /** Returns field FieldIndex (0 .. Record.NumFields - 1) of a record in this view. */
+    const FGameplayEventField& GetField(const FGameplayEventRecord& Record, int32 FieldIndex) const
+    {
+        return Fields[GetFieldIndex(Record) + FieldIndex];
+    }
+
+    /** Returns the first field of Record named Key, or nullptr. */
+    const FGameplayEventField* FindField(const FGameplayEventRecord& Record, FName Key) const
+    {
+        for (int32 FieldIndex = 0; FieldIndex < Record.NumFields; ++FieldIndex)
+        {
+            const FGameplayEventField& Field = GetField(Record, FieldIndex);
+            if (Field.Key == Key)
+            {
+                return &Field;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Builds the Blueprint-facing entry for one record. */
+    FGameplayEventEntry MakeEntry(int32 Index) const
+    {
+        const FGameplayEventRecord& Record = Records[Index];
+
+        FString RenderedFields;
+        FGameplayEventField::AppendAll(Fields, GetFieldIndex(Record), Record.NumFields, RenderedFields);
+
+        return FGameplayEventEntry(ResolveString(Record.NameId), Record.Context, static_cast<float>(Record.GameTime), Clock.ToUtc(Record.Cycles), MoveTemp(RenderedFields),
+            ResolveString(Record.OwnerId));
+    }
+
+    /** Index of the record's first field within Fields. */
+    int32 GetFieldIndex(const FGameplayEventRecord& Record) const
+    {
+        return static_cast<int32>(Record.FirstFieldId - Fields.GetFirstId());
+    }
 };
 
 /**
@@ -34,6 +375,10 @@ struct FGameplayEventEntry
  * supports filtering, exporting, and querying logs.
  * 
  * Designed for advanced QA, telemetry, debugging, and postmortem analysis.
+ *
+ * With bUseSharedEventStore the component is only a handle: events are tagged with the
+ * owning actor and stored in the world's UGameplayEventLogSubsystem, which keeps one
+ * timeline for every such logger.
  */
 UCLASS(ClassGroup = (DevTools), meta = (BlueprintSpawnableComponent))
 class YOURPROJECT_API UGameplayEventLogger : public UActorComponent
@@ -43,10 +388,91 @@ class YOURPROJECT_API UGameplayEventLogger : public UActorComponent
 public:
     UGameplayEventLogger();
 
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
     /** Logs an event with optional context information. Thread-safe. */
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
     void LogEvent(const FString& EventName, const FString& Context = TEXT(""));
 
+    /**
+     * Logs an event with typed fields. Values are stored raw and only formatted when the event
+     * is dumped, echoed or exported, so callers no longer need to Printf into Context. Thread-safe.
+     */
+    void LogStructuredEvent(const FString& EventName, FGameplayEventFields Fields, const FString& Context = TEXT(""));
+
+    /**
+     * Logs an event type declared with DECLARE_GAMEPLAY_EVENT(_WithFields), passing one value per
+     * declared field. The name resolves through a per-schema id cache, so no string is hashed,
+     * copied or validated per call. Thread-safe.
+     */
+    template <typename SchemaType, typename... ArgTypes>
+    void LogTypedEvent(ArgTypes&&... Args)
+    {
+        const int32 NameId = GetSchemaNameId(SchemaType::GetInfo());
+        const double GameTime = GetCurrentGameTime();
+        if (!AdmitEvent(NameId, GameTime))
+        {
+            return;
+        }
+
+        TArray<FGameplayEventField> Fields;
+        SchemaType::MakeFields(Fields, Forward<ArgTypes>(Args)...);
+        LogEventInternal(NameId, FString(), GameTime, MoveTemp(Fields));
+    }
+
+    /**
+     * Installs or replaces the sampling rule for Rule.EventName. Takes effect immediately on every
+     * thread; suppressed events are counted but not stored.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Sampling")
+    void SetSamplingRule(const FGameplayEventSamplingRule& Rule);
+
+    /** Removes the sampling rule for EventName, so all its events are logged again. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Sampling")
+    void RemoveSamplingRule(const FString& EventName);
+
+    /** Returns how many events named EventName were suppressed by its current sampling rule. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Sampling")
+    int64 GetSuppressedEventCount(const FString& EventName) const;
+
+    /** Returns how many events were suppressed by sampling rules in total. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Sampling")
+    int64 GetTotalSuppressedEventCount() const;
+
+    /**
+     * Reads the rolling aggregate of EventName in O(buckets), without touching the event log.
+     * Returns false if aggregates are disabled or the name was never logged.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Aggregates")
+    bool GetEventAggregate(const FString& EventName, FGameplayEventAggregate& OutAggregate) const;
+
+    /** Returns the rolling aggregate of every event name logged so far. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Aggregates")
+    TArray<FGameplayEventAggregate> GetAllEventAggregates() const;
+
+    /** Zeroes every aggregate. ClearLog leaves aggregates untouched. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Aggregates")
+    void ResetEventAggregates();
+
+    /**
+     * Calls OnEvents once per frame on the game thread with the new events matching Filter, instead
+     * of polling the log. Names are matched by handle, so events nobody subscribed to cost nothing
+     * extra. On a shared-store handle only this component's events are delivered. Returns the id
+     * for Unsubscribe.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Subscriptions")
+    int32 SubscribeToEvents(const FGameplayEventSubscriptionFilter& Filter, FGameplayEventBatchReceived OnEvents);
+
+    /** C++ variant of SubscribeToEvents delivering the stored records; Predicate further narrows the matched events. Game thread only. */
+    int32 AddEventSubscription(const FGameplayEventSubscriptionFilter& Filter, FGameplayEventSubscriptions::FCallback OnEvents,
+        FGameplayEventSubscriptions::FPredicate Predicate = nullptr);
+
+    /** Stops a subscription. Events matched but not yet delivered are discarded. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Subscriptions")
+    void Unsubscribe(int32 SubscriptionId);
+
     /** Clears the entire event log. */
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
     void ClearLog();
@@ -59,9 +485,63 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
     bool ExportLogToCSV(const FString& FilePath) const;
 
-    /** Returns all logged events as an array. */
+    /**
+     * Snapshots the event log and writes it to a CSV file on a background thread.
+     * Logging continues while the file is written; OnComplete fires on the game thread.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    void ExportLogToCSVAsync(const FString& FilePath, FGameplayEventExportComplete OnComplete) const;
+
+    /** Exports the event log to a compact binary .gelog file (see GameplayEventBinaryLog.h). Typed fields are not stored. Returns success. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    bool ExportLogToBinary(const FString& FilePath) const;
+
+    /**
+     * Exports the event log to a block-compressed .gelz file (see GameplayEventCompressedLog.h)
+     * and logs the compression ratio and cost. Returns success.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    bool ExportLogToCompressed(const FString& FilePath, EGameplayEventCompression Compression = EGameplayEventCompression::Zlib) const;
+
+    /** Writes every event queued for the file sink to disk before returning. No-op without a sink. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|File Sink")
+    void FlushFileSink();
+
+    /** Returns how many events the file sink could not queue or write. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|File Sink")
+    int64 GetFileSinkDroppedEventCount() const;
+
+    /** Fills OutStats for the blocks the file sink wrote so far. Returns false unless a compressed sink is running. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|File Sink")
+    bool GetFileSinkCompressionStats(FGameplayEventCompressionStats& OutStats) const;
+
+    /** Converts a binary .gelog file to the CSV layout produced by ExportLogToCSV. Returns success. */
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
-    const TArray<FGameplayEventEntry>& GetEventLog() const;
+    static bool ConvertBinaryLogToCSV(const FString& BinaryPath, const FString& CSVPath);
+
+    /**
+     * Finds the first event where two binary logs, typically captured with bReplayCapture by two
+     * runs of the same session, disagree. Both files are memory-mapped and compared in one linear
+     * pass; wall-clock timestamps are ignored and frame numbers are compared relative to the
+     * alignment point. Returns false if either file cannot be read.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger|Replay")
+    static bool DiffBinaryLogs(const FString& BinaryPathA, const FString& BinaryPathB, FGameplayEventLogDivergence& OutDivergence, float GameTimeTolerance = 0.f);
+
+    /**
+     * Converts the events of a .gelz file with a game time in [MinGameTime, MaxGameTime] to the
+     * CSV layout produced by ExportLogToCSV. A negative MaxGameTime means no upper bound; only
+     * blocks overlapping the range are decompressed. Returns success.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    static bool ConvertCompressedLogToCSV(const FString& CompressedPath, const FString& CSVPath, float MinGameTime = 0.f, float MaxGameTime = -1.f);
+
+    /** Returns a copy of all logged events, materialized from the compact storage. C++ callers should prefer GetEventLogView. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetEventLog() const;
+
+    /** Returns a thread-safe, zero-copy snapshot of the current events. Taking it only copies segment references. */
+    FGameplayEventLogView GetEventLogView() const;
 
     /** Searches events by event name substring (case insensitive). Returns filtered array. */
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
@@ -71,18 +551,354 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
     TArray<FGameplayEventEntry> SearchEventsByContext(const FString& SearchTerm) const;
 
+    /**
+     * Returns events with StartTime <= GameTime <= EndTime. The log is append-ordered, so the range is
+     * found by binary search. PageSize > 0 returns at most PageSize events starting PageStart events
+     * into the range; OutTotalInRange always receives the full range size.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetEventsInGameTimeRange(float StartTime, float EndTime, int32& OutTotalInRange, int32 PageStart = 0, int32 PageSize = 0) const;
+
+    /** Same as GetEventsInGameTimeRange, using the UTC wall-clock timestamp of each event. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetEventsInUtcRange(const FDateTime& Start, const FDateTime& End, int32& OutTotalInRange, int32 PageStart = 0, int32 PageSize = 0) const;
+
+    /** Returns the events logged during the last Seconds of game time, oldest first. Intended for debug HUDs. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetRecentEvents(float Seconds) const;
+
+    /**
+     * Calls Visitor for every event with StartTime <= GameTime <= EndTime without copying the log.
+     * Runs under the logger lock, so Visitor must not call back into this logger. Returns the number visited.
+     */
+    int32 VisitEventsInGameTimeRange(float StartTime, float EndTime, TFunctionRef<void(const FGameplayEventRecord& Record, const FGameplayEventStringTable& Strings)> Visitor) const;
+
+    /**
+     * Returns events that have a field named FieldKey for which Predicate returns true.
+     * Works on the stored values, so no rendered text is parsed. Predicate runs under the logger lock.
+     */
+    TArray<FGameplayEventEntry> FilterEventsByField(FName FieldKey, TFunctionRef<bool(const FGameplayEventField& Field)> Predicate) const;
+
+    /** Returns the events logged by the actor with path name OwnerName, oldest first. Mostly useful on a shared store. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    TArray<FGameplayEventEntry> GetEventsByOwner(const FString& OwnerName) const;
+
     /** Returns the count of logged events. */
     UFUNCTION(BlueprintCallable, Category = "Event Logger")
     int32 GetEventCount() const;
 
+    /** Changes the bounded capacity (0 = unbounded) and overflow policy at runtime. Keeps the newest events that fit. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    void SetLogCapacity(int32 NewMaxEvents, EGameplayEventOverflowPolicy NewPolicy);
+
+    /** Returns how many events were discarded because the bounded log was full. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    int64 GetDroppedEventCount() const;
+
+    /** Returns how many events were written to the spill file because the bounded log was full. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    int64 GetSpilledEventCount() const;
+
+    /** Returns the bytes held by the event storage and the interned string table. */
+    UFUNCTION(BlueprintCallable, Category = "Event Logger")
+    int64 GetLogMemoryBytes() const;
+
 protected:
-    /** Thread-safe storage of gameplay events. */
-    UPROPERTY()
-    TArray<FGameplayEventEntry> EventLog;
+    /** Thread-safe storage of gameplay events, bounded when MaxEvents > 0. */
+    TGameplayEventSegmentedLog<FGameplayEventRecord> EventLog;
+
+    /** Typed fields of the records in EventLog, in the same order. Evicted together with their records. */
+    TGameplayEventSegmentedLog<FGameplayEventField> FieldLog;
+
+    /** Session anchor used to turn record cycle counts back into UTC. Captured once at construction. */
+    FGameplayEventClock Clock;
+
+    /** Interned event names and owners referenced by EventLog. Shared so background exports can outlive the component. */
+    TSharedRef<FGameplayEventStringTable, ESPMode::ThreadSafe> StringTable;
 
     mutable FCriticalSection Mutex; // For thread safety
 
+    /**
+     * When enabled, LogEvent pushes into a lock-free (not wait-free) ring buffer instead of
+     * taking Mutex. Pending events are drained into EventLog once per tick and before every query.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger")
+    bool bUseLockFreeBuffer = false;
+
+    /** Number of slots in the lock-free ring buffer (rounded up to a power of two). */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (EditCondition = "bUseLockFreeBuffer", ClampMin = "2"))
+    int32 LockFreeBufferCapacity = 65536;
+
+    /**
+     * Gives every logging thread its own lock-free ring instead of one shared ring, so producers on
+     * different cores never write the same cache lines. Rings are merged in timestamp order when
+     * drained at the end of each frame or before a query. Read in BeginPlay.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (EditCondition = "bUseLockFreeBuffer"))
+    bool bUsePerThreadBuffers = false;
+
+    /** Number of slots in each per-thread ring (rounded up to a power of two). */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (EditCondition = "bUseLockFreeBuffer && bUsePerThreadBuffers", ClampMin = "2"))
+    int32 PerThreadBufferCapacity = 4096;
+
+    /**
+     * Maintains a name/context search index as events are stored, so SearchEventsByName and
+     * SearchEventsByContext avoid scanning the log. Costs 16 bytes per stored event, released as
+     * events are evicted, plus a lowercased copy and trigrams of every distinct name, kept for the
+     * logger's lifetime, and of every distinct context still in the log. Read in BeginPlay.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger")
+    bool bEnableSearchIndex = true;
+
+    /** Echo behavior for editor builds. Async keeps per-event formatting off the logging threads. Read in BeginPlay. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Echo")
+    EGameplayEventEchoMode EchoMode = EGameplayEventEchoMode::Immediate;
+
+    /** When not empty, only events with one of these names (exact match) are echoed. Read in BeginPlay. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Echo")
+    TArray<FString> EchoEventNames;
+
+    /** Seconds between batched echo flushes in Async mode. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Echo", meta = (EditCondition = "EchoMode == EGameplayEventEchoMode::Async", ClampMin = "0.01"))
+    float EchoFlushInterval = 0.1f;
+
+    /**
+     * When disabled, events only update the aggregates (and nothing is stored or echoed),
+     * for production builds that only need counts.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Aggregates")
+    bool bRetainRawEvents = true;
+
+    /** Maintains per-name counts, rate and first/last seen times as events are logged. Read in BeginPlay. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Aggregates")
+    bool bEnableAggregates = true;
+
+    /** Game-time length of one aggregate bucket. Read in BeginPlay. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Aggregates", meta = (EditCondition = "bEnableAggregates", ClampMin = "0.001"))
+    float AggregateBucketSeconds = 60.f;
+
+    /** Number of buckets kept per event name; older buckets are reused. Read in BeginPlay. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Aggregates", meta = (EditCondition = "bEnableAggregates", ClampMin = "1"))
+    int32 AggregateBucketCount = 60;
+
+    /**
+     * Continuously appends stored events to a CSV file from a background thread, so a crash
+     * loses at most one flush interval. Read in BeginPlay.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink")
+    bool bEnableFileSink = false;
+
+    /**
+     * File the sink appends to. Empty uses Saved/Logs/<Owner>_<Component>_Events.csv, or a
+     * timestamped .gelz file when compressed. A compressed sink starts its file over.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink"))
+    FString FileSinkPath;
+
+    /** Seconds between batched writes. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink", ClampMin = "0.01"))
+    float FileSinkFlushInterval = 0.5f;
+
+    /** Events the sink can fall behind by before new ones are dropped from the file (the in-memory log keeps them). */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink", ClampMin = "2"))
+    int32 FileSinkQueueCapacity = 65536;
+
+    /** Writes independently compressed, time-indexed blocks (.gelz) instead of plain CSV. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink"))
+    EGameplayEventCompression FileSinkCompression = EGameplayEventCompression::None;
+
+    /** Uncompressed size of one compressed block. Larger blocks compress better but are coarser to seek. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink && FileSinkCompression != EGameplayEventCompression::None", ClampMin = "4"))
+    int32 FileSinkBlockSizeKB = 256;
+
+    /** A partly filled block is still written once it is this old, bounding what a hard kill can lose. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|File Sink", meta = (EditCondition = "bEnableFileSink && FileSinkCompression != EGameplayEventCompression::None", ClampMin = "0.01"))
+    float FileSinkMaxBlockSeconds = 5.f;
+
+    /**
+     * Forwards events to the world's UGameplayEventLogSubsystem instead of storing them in this
+     * component. The storage, search, echo and file sink settings of the shared store then apply;
+     * sampling and aggregates stay per component. Queries on this component see no events; query
+     * the subsystem instead. Read in BeginPlay.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Shared Store")
+    bool bUseSharedEventStore = false;
+
+    /**
+     * Stamps every stored event with a 64-bit sequence number from one atomic counter, giving the
+     * store a total order that does not depend on which thread won a lock. Binary exports are
+     * written in sequence order, so captures of two runs can be compared with DiffBinaryLogs.
+     * On a shared-store handle the store's setting applies. Set it before play so every event is numbered.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Replay")
+    bool bReplayCapture = false;
+
+    /** Sampling rules installed in BeginPlay, on top of any set at runtime with SetSamplingRule. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger|Sampling")
+    TArray<FGameplayEventSamplingRule> SamplingRules;
+
+    /**
+     * Maximum number of events kept in memory. 0 keeps every event. Storage grows a segment at a time as events arrive.
+     * Contexts, typed fields and their search index entries are evicted with their records, so
+     * memory stays bounded whatever their cardinality. Only event names and owners stay interned
+     * in StringTable for the logger's lifetime, ClearLog included.
+     */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (ClampMin = "0"))
+    int32 MaxEvents = 0;
+
+    /** What to do with new events once MaxEvents is reached. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (EditCondition = "MaxEvents > 0"))
+    EGameplayEventOverflowPolicy OverflowPolicy = EGameplayEventOverflowPolicy::OverwriteOldest;
+
+    /** Spill file for SpillOldestToDisk. Empty uses Saved/Logs/<Owner>_<Component>_Spill.csv. */
+    UPROPERTY(EditAnywhere, Category = "Event Logger", meta = (EditCondition = "OverflowPolicy == EGameplayEventOverflowPolicy::SpillOldestToDisk"))
+    FString SpillFilePath;
+
 private:
-    /** Internal helper to sanitize strings for CSV export. */
-    FString SanitizeForCSV(const FString& Input) const;
+    /** The subsystem creates, drains and shuts down the shared store. */
+    friend class UGameplayEventLogSubsystem;
+
+    /** Configures and opens storage directly to time concurrent producers. */
+    friend class FGameplayEventLoggerThroughputTest;
+
+    /** Store events are forwarded to while bUseSharedEventStore is in effect; null otherwise. Owned by the subsystem. */
+    UPROPERTY(Transient)
+    UGameplayEventLogger* SharedStore = nullptr;
+
+    /** Listeners for stored events, dispatched from TickComponent (or the subsystem's tick for the shared store). */
+    FGameplayEventSubscriptions Subscriptions;
+
+    /** Ids of subscriptions this handle registered on SharedStore, removed in EndPlay. */
+    TArray<int32> ForwardedSubscriptionIds;
+
+    /** Last sequence number handed out while bReplayCapture is set. */
+    std::atomic<uint64> LastSequence{ 0 };
+
+    /** Handle of the owning actor's path name, stamped on every record. Set in BeginPlay. */
+    int32 OwnerId = FGameplayEventStringTable::EmptyHandle;
+
+    /** Search index over EventLog, active once BeginPlay has seen bEnableSearchIndex. Guarded by Mutex. */
+    FGameplayEventSearchIndex SearchIndex;
+    bool bSearchIndexActive = false;
+
+    /** Background file writer, alive between BeginPlay and EndPlay when bEnableFileSink is set. */
+    TUniquePtr<FGameplayEventFileSink> FileSink;
+
+    /** Background echo thread, alive between BeginPlay and EndPlay in Async mode. */
+    TUniquePtr<FGameplayEventEchoWorker> EchoWorker;
+
+    /** Interned EchoEventNames; empty echoes everything. Written in BeginPlay only. */
+    TSet<int32> EchoNameFilter;
+
+    /** Events discarded by OverwriteOldest/DropNewest. Guarded by Mutex. */
+    int64 DroppedEventCount = 0;
+
+    /** Events written to the spill file. Guarded by Mutex. */
+    int64 SpilledEventCount = 0;
+
+    /** Open spill file while SpillOldestToDisk is active. Guarded by Mutex. */
+    TUniquePtr<IFileHandle> SpillFile;
+
+    /**
+     * Set by BeginStorage once the file sink, echo worker and lock-free buffers exist, cleared by
+     * EndStorage before it releases them. Submitters count themselves in NumSubmitting before reading
+     * the flag, so EndStorage can wait for calls already using those members; events that find
+     * storage closed go straight to EventLog under Mutex.
+     */
+    std::atomic<bool> bStorageOpen{ false };
+    std::atomic<int32> NumSubmitting{ 0 };
+
+    /** Pending events produced on the lock-free path, owned by the logger while playing. */
+    TUniquePtr<TGameplayEventRingBuffer<FGameplayEventPendingRecord>> PendingEvents;
+
+    /** Per-thread rings used instead of PendingEvents when bUsePerThreadBuffers is set. */
+    TUniquePtr<FGameplayEventThreadBuffers> ThreadBuffers;
+
+    /** Per-name sampling rules, evaluated before an event is built. */
+    FGameplayEventSampler Sampler;
+
+    /** Rolling per-name counters, created in BeginPlay when bEnableAggregates is set. */
+    TUniquePtr<FGameplayEventAggregator> Aggregator;
+
+    /** String handles of declared event names, indexed by schema id. 0 (the empty string) means not interned yet. */
+    TUniquePtr<std::atomic<int32>[]> SchemaNameIds;
+
+    /** Shared implementation of LogEvent, LogStructuredEvent and LogTypedEvent. */
+    void LogEventInternal(int32 NameId, FString&& Context, double GameTime, TArray<FGameplayEventField>&& Fields);
+
+    /** Sends a built record to the file sink and echo, then stores or queues it. Called on the shared store by handles. */
+    void SubmitRecord(FGameplayEventRecord&& Record, TArray<FGameplayEventField>&& Fields);
+
+    /**
+     * Hands a record to the file sink and echo and tries to queue it. Returns false, leaving Record
+     * and Fields with the caller, if it must be stored under Mutex. Storage must be open.
+     */
+    bool ForwardAndQueue(FGameplayEventRecord& Record, TArray<FGameplayEventField>& Fields);
+
+    /** Sets up local storage, file sink, echo and lock-free buffers. BeginPlay, or the subsystem for the shared store. */
+    void BeginStorage();
+
+    /** Drains, flushes and releases what BeginStorage set up. */
+    void EndStorage();
+
+    /** Switches this component to a handle of Store, sharing its string table and clock. */
+    void AttachToSharedStore(UGameplayEventLogger& Store);
+
+    /** Moves pending lock-free events into EventLog. */
+    void DrainPendingEvents();
+
+    /** Delivers the batches matched since the last call to their subscribers. Game thread only. */
+    void DispatchSubscriptions();
+
+    /** Records the event in the aggregates, then returns false when it is not retained or a sampling rule drops it. */
+    bool AdmitEvent(int32 NameId, double GameTime);
+
+    /** World time in seconds, at the precision the engine keeps it (double from UE5). */
+    double GetCurrentGameTime() const;
+
+    /** Returns the string handle of a declared event name, interning it on first use. */
+    int32 GetSchemaNameId(const FGameplayEventSchemaInfo& Schema);
+
+    /** Echoes a logged record to the output log according to EchoMode and EchoEventNames. */
+    void EchoRecord(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields);
+
+    /** Appends a record and its fields, applying OverflowPolicy when the log is full. Caller must hold Mutex. */
+    void StoreRecord_Locked(FGameplayEventRecord&& Record, TArrayView<const FGameplayEventField> Fields);
+
+    /** Drops fields whose records were evicted from EventLog. Caller must hold Mutex. */
+    void TrimFields_Locked();
+
+    /** Renders the fields of a stored record. Caller must hold Mutex. */
+    FString RenderFields_Locked(const FGameplayEventRecord& Record) const;
+
+    /** Writes the oldest NumToSpill records to the spill file and frees their slots. Caller must hold Mutex. */
+    void SpillOldest_Locked(int32 NumToSpill);
+
+    /** Applies MaxEvents/OverflowPolicy to EventLog and opens or closes the spill file. Caller must hold Mutex. */
+    void ApplyCapacity_Locked();
+
+    /** Moves pending lock-free events into EventLog, merging per-thread rings by timestamp. Caller must hold Mutex. */
+    void DrainPendingEvents_Locked() const;
+
+    /** Returns entries whose name or context contains SearchTerm, ignoring case. Caller must hold Mutex. */
+    TArray<FGameplayEventEntry> SearchEvents_Locked(const FString& SearchTerm, EGameplayEventSearchField Field) const;
+
+    /** Adds the most recently stored record to SearchIndex. Caller must hold Mutex. */
+    void IndexRecord_Locked(const FGameplayEventRecord& Record);
+
+    /** Removes the NumRecords oldest records from SearchIndex, before they are evicted. Caller must hold Mutex. */
+    void UnindexOldest_Locked(int32 NumRecords);
+
+    /** Rebuilds SearchIndex from every stored record. Caller must hold Mutex. */
+    void RebuildSearchIndex_Locked();
+
+    /** Returns the logical index range [OutFirst, OutLast) of records whose key lies in [Min, Max]. Caller must hold Mutex. */
+    template <typename KeyType, typename ProjectionType>
+    void FindRange_Locked(KeyType Min, KeyType Max, ProjectionType Projection, int32& OutFirst, int32& OutLast) const;
+
+    /** Materializes one page of the logical index range [First, Last). */
+    TArray<FGameplayEventEntry> MakePage_Locked(int32 First, int32 Last, int32 PageStart, int32 PageSize) const;
+
+    /** Builds the Blueprint-facing entry for a stored record. */
+    FGameplayEventEntry MakeEntry(const FGameplayEventRecord& Record) const;
 };
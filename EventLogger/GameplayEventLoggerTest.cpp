@@ -0,0 +1,116 @@
+#include "GameplayEventLogger.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GameplayEventLoggerTestPrivate
+{
+    /** Events logged per run, split evenly across the producer threads. */
+    constexpr int32 EventsPerRun = 1 << 18;
+
+    /** Distinct event names and, per thread, contexts cycled through, so producers do not format strings while timed. */
+    constexpr int32 NumNames = 8;
+    constexpr int32 NumContexts = 256;
+
+    /** How LogEvent hands events over to storage. */
+    struct FProducerPath
+    {
+        const TCHAR* Name;
+        bool bUseLockFreeBuffer;
+        bool bUsePerThreadBuffers;
+    };
+
+    const FProducerPath ProducerPaths[] =
+    {
+        { TEXT("Mutex"), false, false },
+        { TEXT("Ring buffer"), true, false },
+        { TEXT("Per-thread buffers"), true, true },
+    };
+
+    const int32 ProducerThreadCounts[] = { 1, 4, 16, 64 };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayEventLoggerThroughputTest, "YourProject.GameplayEventLogger.Throughput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGameplayEventLoggerThroughputTest::RunTest(const FString& Parameters)
+{
+    using namespace GameplayEventLoggerTestPrivate;
+
+    TArray<FString> Names;
+    for (int32 Index = 0; Index < NumNames; ++Index)
+    {
+        Names.Add(FString::Printf(TEXT("Benchmark.Event%d"), Index));
+    }
+
+    for (const FProducerPath& Path : ProducerPaths)
+    {
+        for (const int32 NumThreads : ProducerThreadCounts)
+        {
+            const int32 EventsPerThread = EventsPerRun / NumThreads;
+
+            UGameplayEventLogger* Logger = NewObject<UGameplayEventLogger>(GetTransientPackage());
+            Logger->EchoMode = EGameplayEventEchoMode::Off;
+            Logger->bUseLockFreeBuffer = Path.bUseLockFreeBuffer;
+            Logger->bUsePerThreadBuffers = Path.bUsePerThreadBuffers;
+
+            // Sized so no event overflows to the mutex path while producers run
+            Logger->LockFreeBufferCapacity = EventsPerRun;
+            Logger->PerThreadBufferCapacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(EventsPerThread)));
+            Logger->BeginStorage();
+
+            // Threads are started first and released together, so thread creation is not timed
+            FEvent* StartEvent = FPlatformProcess::GetSynchEventFromPool(true);
+            TArray<TFuture<void>> Producers;
+            for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+            {
+                Producers.Add(Async(EAsyncExecution::Thread, [Logger, &Names, StartEvent, ThreadIndex, EventsPerThread]()
+                {
+                    TArray<FString> Contexts;
+                    for (int32 Index = 0; Index < NumContexts; ++Index)
+                    {
+                        Contexts.Add(FString::Printf(TEXT("Thread=%d Item=%d"), ThreadIndex, Index));
+                    }
+
+                    StartEvent->Wait();
+                    for (int32 Index = 0; Index < EventsPerThread; ++Index)
+                    {
+                        Logger->LogEvent(Names[Index % NumNames], Contexts[Index % NumContexts]);
+                    }
+                }));
+            }
+
+            // Give every thread time to reach the gate
+            FPlatformProcess::Sleep(0.05f);
+
+            const double StartSeconds = FPlatformTime::Seconds();
+            StartEvent->Trigger();
+            for (TFuture<void>& Producer : Producers)
+            {
+                Producer.Wait();
+            }
+            const double ProduceSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+            // Queued events are stored by the first query
+            const double DrainStartSeconds = FPlatformTime::Seconds();
+            const int32 NumStored = Logger->GetEventCount();
+            const double DrainSeconds = FPlatformTime::Seconds() - DrainStartSeconds;
+
+            FPlatformProcess::ReturnSynchEventToPool(StartEvent);
+            Logger->EndStorage();
+
+            const int32 NumLogged = EventsPerThread * NumThreads;
+            TestEqual(FString::Printf(TEXT("%s, %d thread(s): every event is stored"), Path.Name, NumThreads), NumStored, NumLogged);
+
+            AddInfo(FString::Printf(TEXT("%s, %2d thread(s): %8.0f events/ms logging, %6.2f ms draining %d events."),
+                Path.Name, NumThreads, NumLogged / FMath::Max(ProduceSeconds * 1000.0, 1e-6), DrainSeconds * 1000.0, NumLogged));
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+/**
+ * TGameplayEventRingBuffer
+ * ------------------------
+ * Bounded multi-producer / single-consumer ring buffer used by UGameplayEventLogger
+ * to accept events from any thread without taking the logger mutex.
+ *
+ * Producers claim a slot with a CAS on the enqueue cursor and publish it by bumping the
+ * slot sequence. The consumer walks slots in order and stops at the first slot that has
+ * not been published yet, so drained events keep their claim order.
+ *
+ * Enqueue is lock-free, not wait-free: a producer that loses the CAS to another producer
+ * retries, so some producer always makes progress but one producer can retry while others
+ * keep winning. A stalled producer never blocks the others.
+ *
+ * Only one thread may call Dequeue/Drain at a time; the logger guarantees this by
+ * draining under its own mutex.
+ */
+template <typename ElementType>
+class TGameplayEventRingBuffer
+{
+public:
+    /** Creates a ring with at least InCapacity slots (rounded up to a power of two). */
+    explicit TGameplayEventRingBuffer(uint32 InCapacity)
+    {
+        Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+        IndexMask = Capacity - 1;
+        Slots = MakeUnique<FSlot[]>(Capacity);
+
+        for (uint32 Index = 0; Index < Capacity; ++Index)
+        {
+            Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+        }
+    }
+
+    TGameplayEventRingBuffer(const TGameplayEventRingBuffer&) = delete;
+    TGameplayEventRingBuffer& operator=(const TGameplayEventRingBuffer&) = delete;
+
+    /** Pushes an item from any thread. Lock-free; returns false if the ring is full. */
+    bool TryEnqueue(ElementType&& Item)
+    {
+        FSlot* Slot = nullptr;
+        uint64 Pos = EnqueuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Slot = &Slots[Pos & IndexMask];
+            const uint64 Seq = Slot->Sequence.load(std::memory_order_acquire);
+            const int64 Diff = static_cast<int64>(Seq) - static_cast<int64>(Pos);
+
+            if (Diff == 0)
+            {
+                if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                // Consumer has not freed this slot yet
+                return false;
+            }
+            else
+            {
+                Pos = EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        Slot->Value = MoveTemp(Item);
+        Slot->Sequence.store(Pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Pops the oldest published item. Consumer side only. */
+    bool Dequeue(ElementType& OutItem)
+    {
+        FSlot& Slot = Slots[DequeuePos & IndexMask];
+        const uint64 Seq = Slot.Sequence.load(std::memory_order_acquire);
+
+        if (Seq != DequeuePos + 1)
+        {
+            return false;
+        }
+
+        OutItem = MoveTemp(Slot.Value);
+        Slot.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+        ++DequeuePos;
+        return true;
+    }
+
+    /** Moves every published item into Sink in order. Consumer side only. Returns the number drained. */
+    template <typename SinkType>
+    int32 Drain(SinkType&& Sink)
+    {
+        int32 NumDrained = 0;
+        ElementType Item;
+
+        while (Dequeue(Item))
+        {
+            Sink(MoveTemp(Item));
+            ++NumDrained;
+        }
+
+        return NumDrained;
+    }
+
+    /** Approximate number of items waiting to be drained. */
+    uint32 GetApproximateNum() const
+    {
+        const uint64 Enqueued = EnqueuePos.load(std::memory_order_relaxed);
+        return Enqueued > DequeuePos ? static_cast<uint32>(Enqueued - DequeuePos) : 0;
+    }
+
+    uint32 GetCapacity() const { return Capacity; }
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence;
+        ElementType Value;
+    };
+
+    TUniquePtr<FSlot[]> Slots;
+    uint32 Capacity = 0;
+    uint32 IndexMask = 0;
+
+    /** Producer cursor, kept on its own cache line so producers don't bounce the consumer's line. */
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{ 0 };
+
+    /** Consumer cursor, only touched by the draining thread. */
+    alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+};
@@ -0,0 +1,217 @@
+#include "GameplayEventSampler.h"
+#include "GameplayEventLogger.h"
+#include "HAL/PlatformTime.h"
+
+struct FGameplayEventSampler::FRuleState
+{
+    EGameplayEventSamplingMode Mode = EGameplayEventSamplingMode::KeepAll;
+
+    /** OneInN: N. FirstNPerWindow: events kept per window. */
+    uint64 Count = 1;
+
+    /** TokenBucket: cycles between kept events, and how far the arrival time may run ahead of now. */
+    uint64 IntervalCycles = 0;
+    uint64 BurstCycles = 0;
+
+    /** FirstNPerWindow: window length in cycles. */
+    uint64 WindowCycles = 1;
+
+    /** Limiter word: OneInN event counter, TokenBucket arrival time, or FirstNPerWindow (window << 32 | kept). */
+    std::atomic<uint64> State{ 0 };
+
+    std::atomic<uint64> NumSeen{ 0 };
+    std::atomic<uint64> NumSuppressed{ 0 };
+
+    void Configure(const FGameplayEventSamplingRule& Rule)
+    {
+        const double CyclesPerSecond = 1.0 / FPlatformTime::GetSecondsPerCycle64();
+
+        Mode = Rule.Mode;
+        Count = static_cast<uint64>(FMath::Max(Rule.Count, 1));
+        IntervalCycles = static_cast<uint64>(CyclesPerSecond / FMath::Max(Rule.RatePerSecond, KINDA_SMALL_NUMBER));
+        BurstCycles = IntervalCycles * static_cast<uint64>(FMath::Max(Rule.BurstSize, 1) - 1);
+        WindowCycles = FMath::Max<uint64>(static_cast<uint64>(CyclesPerSecond * FMath::Max(Rule.WindowSeconds, 0.001f)), 1);
+        State.store(0, std::memory_order_relaxed);
+    }
+
+    bool Admit(uint64 Cycles)
+    {
+        switch (Mode)
+        {
+        case EGameplayEventSamplingMode::OneInN:
+            return State.fetch_add(1, std::memory_order_relaxed) % Count == 0;
+
+        case EGameplayEventSamplingMode::TokenBucket:
+        {
+            uint64 ArrivalTime = State.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const uint64 Start = FMath::Max(ArrivalTime, Cycles);
+                if (Start - Cycles > BurstCycles)
+                {
+                    return false;
+                }
+                if (State.compare_exchange_weak(ArrivalTime, Start + IntervalCycles, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+        }
+
+        case EGameplayEventSamplingMode::FirstNPerWindow:
+        {
+            const uint64 Window = (Cycles / WindowCycles) & 0xFFFFFFFF;
+            uint64 Packed = State.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const bool bSameWindow = (Packed >> 32) == Window;
+                const uint64 Kept = bSameWindow ? (Packed & 0xFFFFFFFF) : 0;
+                if (Kept >= Count)
+                {
+                    return false;
+                }
+                if (State.compare_exchange_weak(Packed, (Window << 32) | (Kept + 1), std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+        }
+
+        default:
+            return true;
+        }
+    }
+};
+
+struct FGameplayEventSampler::FRuleTable
+{
+    explicit FRuleTable(int32 InNum)
+        : Num(InNum)
+        , Slots(MakeUnique<std::atomic<FRuleState*>[]>(InNum))
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            Slots[Index].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    const int32 Num;
+    TUniquePtr<std::atomic<FRuleState*>[]> Slots;
+};
+
+namespace GameplayEventSamplerPrivate
+{
+    /** Slots in the first rule table; later tables at least double. */
+    constexpr int32 MinTableSize = 64;
+}
+
+FGameplayEventSampler::FGameplayEventSampler() = default;
+FGameplayEventSampler::~FGameplayEventSampler() = default;
+
+void FGameplayEventSampler::SetRule(int32 NameId, const FGameplayEventSamplingRule& Rule)
+{
+    if (NameId < 0)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&WriteLock);
+
+    FRuleTable* Current = Table.load(std::memory_order_relaxed);
+    if (!Current || NameId >= Current->Num)
+    {
+        const int32 NewNum = FMath::Max(NameId + 1, Current ? Current->Num * 2 : GameplayEventSamplerPrivate::MinTableSize);
+        TUniquePtr<FRuleTable> Grown = MakeUnique<FRuleTable>(NewNum);
+
+        for (int32 Index = 0; Current && Index < Current->Num; ++Index)
+        {
+            Grown->Slots[Index].store(Current->Slots[Index].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        Current = Grown.Get();
+        Tables.Add(MoveTemp(Grown));
+        Table.store(Current, std::memory_order_release);
+    }
+
+    // A new state instead of reconfiguring in place, since loggers may be reading the old one right now
+    TUniquePtr<FRuleState> State = MakeUnique<FRuleState>();
+    State->Configure(Rule);
+
+    if (const FRuleState* Previous = Current->Slots[NameId].load(std::memory_order_relaxed))
+    {
+        State->NumSeen.store(Previous->NumSeen.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        State->NumSuppressed.store(Previous->NumSuppressed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    else
+    {
+        NumRules.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Current->Slots[NameId].store(State.Get(), std::memory_order_release);
+    States.Add(MoveTemp(State));
+}
+
+void FGameplayEventSampler::RemoveRule(int32 NameId)
+{
+    FScopeLock Lock(&WriteLock);
+
+    FRuleTable* Current = Table.load(std::memory_order_relaxed);
+    if (Current && NameId >= 0 && NameId < Current->Num && Current->Slots[NameId].exchange(nullptr, std::memory_order_relaxed))
+    {
+        NumRules.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+FGameplayEventSampler::FRuleState* FGameplayEventSampler::FindRule(int32 NameId) const
+{
+    const FRuleTable* Current = Table.load(std::memory_order_acquire);
+    if (!Current || NameId < 0 || NameId >= Current->Num)
+    {
+        return nullptr;
+    }
+
+    return Current->Slots[NameId].load(std::memory_order_acquire);
+}
+
+bool FGameplayEventSampler::ShouldKeep(int32 NameId, uint64 Cycles)
+{
+    if (!HasRules())
+    {
+        return true;
+    }
+
+    FRuleState* Rule = FindRule(NameId);
+    if (!Rule)
+    {
+        return true;
+    }
+
+    Rule->NumSeen.fetch_add(1, std::memory_order_relaxed);
+    if (Rule->Admit(Cycles))
+    {
+        return true;
+    }
+
+    Rule->NumSuppressed.fetch_add(1, std::memory_order_relaxed);
+    TotalSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+uint64 FGameplayEventSampler::GetSuppressedCount(int32 NameId) const
+{
+    const FRuleState* Rule = FindRule(NameId);
+    return Rule ? Rule->NumSuppressed.load(std::memory_order_relaxed) : 0;
+}
+
+void FGameplayEventSampler::ForEachRule(TFunctionRef<void(int32 NameId, uint64 NumSeen, uint64 NumSuppressed)> Visitor) const
+{
+    const FRuleTable* Current = Table.load(std::memory_order_acquire);
+
+    for (int32 NameId = 0; Current && NameId < Current->Num; ++NameId)
+    {
+        if (const FRuleState* Rule = Current->Slots[NameId].load(std::memory_order_acquire))
+        {
+            Visitor(NameId, Rule->NumSeen.load(std::memory_order_relaxed), Rule->NumSuppressed.load(std::memory_order_relaxed));
+        }
+    }
+}
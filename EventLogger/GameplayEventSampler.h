@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FGameplayEventSamplingRule;
+
+/**
+ * FGameplayEventSampler
+ * ---------------------
+ * Per-event-name sampling and rate limiting for UGameplayEventLogger.
+ *
+ * Rules are published in a table of atomic pointers indexed by the interned name handle, so
+ * deciding whether an event is kept is one array lookup plus a few atomics, from any thread,
+ * without taking a lock. Each limiter keeps its state in a single atomic word:
+ *
+ * - OneInN counts events and keeps every Nth.
+ * - TokenBucket uses the generic cell rate algorithm: the theoretical arrival time of the
+ *   next event advances by 1/Rate per kept event and may run ahead of now by Burst - 1 intervals.
+ * - FirstNPerWindow packs the current window index and the events kept in it.
+ *
+ * Every decision is counted, so suppressed events still show up in the totals.
+ *
+ * A logging thread may still hold a rule or table that SetRule or RemoveRule just replaced, so
+ * replaced rules and outgrown tables are retired rather than freed and released with the sampler.
+ * Rule changes are rare configuration calls, so what they retire stays small.
+ */
+class YOURPROJECT_API FGameplayEventSampler
+{
+public:
+    FGameplayEventSampler();
+    ~FGameplayEventSampler();
+
+    /** Installs or replaces the rule for NameId. Counters of a replaced rule are carried over. */
+    void SetRule(int32 NameId, const FGameplayEventSamplingRule& Rule);
+
+    /** Removes the rule for NameId; its events are kept again. */
+    void RemoveRule(int32 NameId);
+
+    /** True when at least one rule is installed. Lets LogEvent skip the lookup entirely. */
+    bool HasRules() const { return NumRules.load(std::memory_order_relaxed) > 0; }
+
+    /** Decides whether an event named NameId, logged at Cycles, is kept. Thread-safe and lock-free. */
+    bool ShouldKeep(int32 NameId, uint64 Cycles);
+
+    /** Events suppressed under the rule for NameId since it was installed, 0 without a rule. */
+    uint64 GetSuppressedCount(int32 NameId) const;
+
+    /** Events suppressed by every rule, including removed ones. */
+    uint64 GetTotalSuppressed() const { return TotalSuppressed.load(std::memory_order_relaxed); }
+
+    /** Calls Visitor with the counters of every installed rule. */
+    void ForEachRule(TFunctionRef<void(int32 NameId, uint64 NumSeen, uint64 NumSuppressed)> Visitor) const;
+
+private:
+    struct FRuleState;
+    struct FRuleTable;
+
+    /** Returns the published rule for NameId, or null when the name is not sampled. Lock-free. */
+    FRuleState* FindRule(int32 NameId) const;
+
+    /** Serializes SetRule and RemoveRule. ShouldKeep never takes it. */
+    FCriticalSection WriteLock;
+
+    /** Current rule per name handle; a null slot means the name is not sampled. */
+    std::atomic<FRuleTable*> Table{ nullptr };
+
+    /** Every table and rule ever published, owned here because readers may still hold retired ones. Guarded by WriteLock. */
+    TArray<TUniquePtr<FRuleTable>> Tables;
+    TArray<TUniquePtr<FRuleState>> States;
+
+    std::atomic<int32> NumRules{ 0 };
+    std::atomic<uint64> TotalSuppressed{ 0 };
+};
@@ -0,0 +1,74 @@
+#include "GameplayEventSchema.h"
+#include "Misc/ScopeLock.h"
+
+namespace GameplayEventSchemaPrivate
+{
+    struct FRegistryState
+    {
+        FCriticalSection Mutex;
+        TArray<const FGameplayEventSchemaInfo*> Schemas;
+    };
+
+    /** Function-local so schemas registered during static initialization find it constructed. */
+    FRegistryState& GetState()
+    {
+        static FRegistryState State;
+        return State;
+    }
+}
+
+FGameplayEventSchemaInfo::FGameplayEventSchemaInfo(const TCHAR* InName, const TCHAR* InCategory, const TCHAR* const* FieldNames, int32 NumFields)
+    : Name(InName)
+    , Category(InCategory)
+{
+    FieldKeys.Reserve(NumFields);
+    for (int32 Index = 0; Index < NumFields; ++Index)
+    {
+        FieldKeys.Add(FName(FieldNames[Index]));
+    }
+
+    Id = FGameplayEventSchemaRegistry::Register(*this);
+}
+
+int32 FGameplayEventSchemaRegistry::Register(const FGameplayEventSchemaInfo& Schema)
+{
+    GameplayEventSchemaPrivate::FRegistryState& State = GameplayEventSchemaPrivate::GetState();
+    FScopeLock Lock(&State.Mutex);
+
+    if (State.Schemas.Num() >= MaxSchemas)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[GameplayEventLogger] More than %d event schemas declared; '%s' will be logged by name."), MaxSchemas, *Schema.Name);
+        return INDEX_NONE;
+    }
+
+    return State.Schemas.Add(&Schema);
+}
+
+const FGameplayEventSchemaInfo* FGameplayEventSchemaRegistry::Find(int32 Id)
+{
+    GameplayEventSchemaPrivate::FRegistryState& State = GameplayEventSchemaPrivate::GetState();
+    FScopeLock Lock(&State.Mutex);
+    return State.Schemas.IsValidIndex(Id) ? State.Schemas[Id] : nullptr;
+}
+
+const FGameplayEventSchemaInfo* FGameplayEventSchemaRegistry::FindByName(const FString& Name)
+{
+    GameplayEventSchemaPrivate::FRegistryState& State = GameplayEventSchemaPrivate::GetState();
+    FScopeLock Lock(&State.Mutex);
+
+    for (const FGameplayEventSchemaInfo* Schema : State.Schemas)
+    {
+        if (Schema->Name.Equals(Name, ESearchCase::CaseSensitive))
+        {
+            return Schema;
+        }
+    }
+    return nullptr;
+}
+
+int32 FGameplayEventSchemaRegistry::Num()
+{
+    GameplayEventSchemaPrivate::FRegistryState& State = GameplayEventSchemaPrivate::GetState();
+    FScopeLock Lock(&State.Mutex);
+    return State.Schemas.Num();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventFields.h"
+
+/**
+ * FGameplayEventSchemaInfo
+ * ------------------------
+ * Runtime description of an event type declared with DECLARE_GAMEPLAY_EVENT. Built once,
+ * the first time the type is logged, and registered with FGameplayEventSchemaRegistry.
+ */
+struct YOURPROJECT_API FGameplayEventSchemaInfo
+{
+    FGameplayEventSchemaInfo(const TCHAR* InName, const TCHAR* InCategory, const TCHAR* const* FieldNames, int32 NumFields);
+
+    /** Process-wide dense id, INDEX_NONE if the registry was full. */
+    int32 Id = INDEX_NONE;
+
+    FString Name;
+    FName Category;
+
+    /** Field keys in declaration order, converted to FName once. */
+    TArray<FName> FieldKeys;
+};
+
+/**
+ * FGameplayEventSchemaRegistry
+ * ----------------------------
+ * Every declared event type, indexed by FGameplayEventSchemaInfo::Id. Ids are small and
+ * dense so loggers can map them to their own string handles with a plain array lookup.
+ */
+class YOURPROJECT_API FGameplayEventSchemaRegistry
+{
+public:
+    /** Upper bound on declared event types; loggers size their id caches with it. */
+    static constexpr int32 MaxSchemas = 1024;
+
+    /** Assigns the next id to Schema. Returns INDEX_NONE once MaxSchemas is reached. */
+    static int32 Register(const FGameplayEventSchemaInfo& Schema);
+
+    /** Returns the schema registered under Id, or nullptr. */
+    static const FGameplayEventSchemaInfo* Find(int32 Id);
+
+    /** Returns the schema declared with this event name, or nullptr. */
+    static const FGameplayEventSchemaInfo* FindByName(const FString& Name);
+
+    static int32 Num();
+};
+
+/**
+ * TGameplayEventSchema
+ * --------------------
+ * Base of declared event types. FieldTypes are the C++ types of the fields in declaration
+ * order; values passed to UGameplayEventLogger::LogTypedEvent are converted to them, and
+ * their count is checked at compile time.
+ */
+template <typename SchemaType, typename... FieldTypes>
+struct TGameplayEventSchema
+{
+    static constexpr int32 NumFields = sizeof...(FieldTypes);
+
+    /** Overridden by DECLARE_GAMEPLAY_EVENT_WithFields. */
+    static constexpr const TCHAR* const* FieldNames = nullptr;
+
+    static const FGameplayEventSchemaInfo& GetInfo()
+    {
+        static_assert(NumFields == 0 || sizeof(SchemaType::FieldNames) == NumFields * sizeof(const TCHAR*), "Every declared field type needs exactly one field name");
+
+        // Thread-safe one-time construction; later calls only read the reference
+        static const FGameplayEventSchemaInfo Info(SchemaType::Name, SchemaType::Category, SchemaType::FieldNames, NumFields);
+        return Info;
+    }
+
+    /** Converts Args to the declared field types and appends them as fields keyed by the declared names. */
+    template <typename... ArgTypes>
+    static void MakeFields(TArray<FGameplayEventField>& OutFields, ArgTypes&&... Args)
+    {
+        static_assert(sizeof...(ArgTypes) == NumFields, "LogTypedEvent needs one value per declared field");
+
+        const FName* Keys = GetInfo().FieldKeys.GetData();
+        int32 Index = 0;
+
+        OutFields.Reserve(NumFields);
+        (OutFields.Add(FGameplayEventField::Make(Keys[Index++], static_cast<FieldTypes>(Forward<ArgTypes>(Args)))), ...);
+        (void)Keys;
+        (void)Index;
+    }
+};
+
+/** Strips the parentheses from a DECLARE_GAMEPLAY_EVENT_WithFields type list. */
+#define GAMEPLAY_EVENT_EXPAND_TYPES(...) __VA_ARGS__
+
+/**
+ * Declares an event type without fields:
+ *
+ *     DECLARE_GAMEPLAY_EVENT(FPlayerRespawnedEvent, "PlayerRespawned", "Gameplay");
+ *     Logger->LogTypedEvent<FPlayerRespawnedEvent>();
+ */
+#define DECLARE_GAMEPLAY_EVENT(TypeName, EventName, EventCategory) \
+    struct TypeName : TGameplayEventSchema<TypeName> \
+    { \
+        static constexpr const TCHAR* Name = TEXT(EventName); \
+        static constexpr const TCHAR* Category = TEXT(EventCategory); \
+    }
+
+/**
+ * Declares an event type with typed fields. FieldTypes is a parenthesized type list, followed
+ * by one field name per type:
+ *
+ *     DECLARE_GAMEPLAY_EVENT_WithFields(FDamageEvent, "Damage", "Combat",
+ *         (double, FVector, const UObject*), TEXT("Amount"), TEXT("Location"), TEXT("Instigator"));
+ *
+ *     Logger->LogTypedEvent<FDamageEvent>(Damage, HitLocation, InstigatorActor);
+ */
+#define DECLARE_GAMEPLAY_EVENT_WithFields(TypeName, EventName, EventCategory, FieldTypes, ...) \
+    struct TypeName : TGameplayEventSchema<TypeName, GAMEPLAY_EVENT_EXPAND_TYPES FieldTypes> \
+    { \
+        static constexpr const TCHAR* Name = TEXT(EventName); \
+        static constexpr const TCHAR* Category = TEXT(EventCategory); \
+        static constexpr const TCHAR* FieldNames[] = { __VA_ARGS__ }; \
+    }
@@ -0,0 +1,272 @@
+#include "GameplayEventSearchIndex.h"
+#include "GameplayEventLogger.h"
+#include "Algo/Sort.h"
+
+void FGameplayEventSearchIndex::Add(const FGameplayEventRecord& Record, uint64 RecordId, const FGameplayEventStringTable& Strings)
+{
+    Names.AddString(Record.NameId, Strings.Resolve(Record.NameId), Strings.Num());
+    Names.Postings[Record.NameId].Ids.Add(RecordId);
+
+    int32 Slot;
+    if (const int32* ExistingSlot = ContextSlots.Find(Record.Context))
+    {
+        Slot = *ExistingSlot;
+    }
+    else
+    {
+        Slot = FreeContextSlots.Num() > 0 ? FreeContextSlots.Pop(false) : Contexts.LowerStrings.Num();
+        ContextSlots.Add(Record.Context, Slot);
+    }
+
+    Contexts.AddString(Slot, Record.Context, 0);
+    Contexts.Postings[Slot].Ids.Add(RecordId);
+}
+
+void FGameplayEventSearchIndex::Remove(const FGameplayEventRecord& Record, uint64 RecordId)
+{
+    if (Names.Postings.IsValidIndex(Record.NameId))
+    {
+        RemoveOldest(Names.Postings[Record.NameId], RecordId);
+    }
+
+    const int32* SlotPtr = ContextSlots.Find(Record.Context);
+    if (!SlotPtr)
+    {
+        return;
+    }
+
+    const int32 Slot = *SlotPtr;
+    RemoveOldest(Contexts.Postings[Slot], RecordId);
+
+    if (Contexts.Postings[Slot].Num() == 0)
+    {
+        // Contexts are mostly unique per event, so keeping them past their last record would grow the index without bound
+        Contexts.RemoveString(Slot);
+        ContextSlots.Remove(Record.Context);
+        FreeContextSlots.Add(Slot);
+    }
+}
+
+void FGameplayEventSearchIndex::RemoveOldest(FPostingList& List, uint64 RecordId)
+{
+    // Records are evicted oldest first, so an evicted id is always the first live one of its list
+    if (List.Num() == 0 || List.Ids[List.First] != RecordId)
+    {
+        return;
+    }
+
+    ++List.First;
+
+    if (List.Num() == 0)
+    {
+        // The handle may never be logged again, so its list gives its memory back
+        List.Ids.Empty();
+        List.First = 0;
+    }
+    else if (List.First >= List.Num())
+    {
+        // Compacting only once the evicted prefix outgrows the live ids keeps removal amortized O(1)
+        List.Ids.RemoveAt(0, List.First, false);
+        List.First = 0;
+    }
+}
+
+void FGameplayEventSearchIndex::Query(const FString& SearchTerm, EGameplayEventSearchField Field, TArray<uint64>& OutRecordIds) const
+{
+    const FStringIndex& Index = Field == EGameplayEventSearchField::Name ? Names : Contexts;
+
+    TArray<int32> Keys;
+    Index.FindMatchingKeys(SearchTerm.ToLower(), Keys);
+
+    const int32 FirstOut = OutRecordIds.Num();
+    int32 NumListsAdded = 0;
+
+    for (const int32 Key : Keys)
+    {
+        if (!Index.Postings.IsValidIndex(Key) || Index.Postings[Key].Num() == 0)
+        {
+            continue;
+        }
+
+        const FPostingList& List = Index.Postings[Key];
+        OutRecordIds.Append(List.Ids.GetData() + List.First, List.Num());
+        ++NumListsAdded;
+    }
+
+    if (NumListsAdded > 1)
+    {
+        // Several strings matched; restore log order across their posting lists
+        Algo::Sort(MakeArrayView(OutRecordIds.GetData() + FirstOut, OutRecordIds.Num() - FirstOut));
+    }
+}
+
+void FGameplayEventSearchIndex::ResetPostings()
+{
+    Names.ResetPostings();
+
+    // Context slots only live as long as records use them
+    Contexts.Reset();
+    ContextSlots.Empty();
+    FreeContextSlots.Empty();
+}
+
+void FGameplayEventSearchIndex::Reset()
+{
+    Names.Reset();
+    Contexts.Reset();
+    ContextSlots.Empty();
+    FreeContextSlots.Empty();
+}
+
+SIZE_T FGameplayEventSearchIndex::GetAllocatedSize() const
+{
+    SIZE_T Total = Names.GetAllocatedSize() + Contexts.GetAllocatedSize() + ContextSlots.GetAllocatedSize()
+        + FreeContextSlots.GetAllocatedSize();
+
+    for (const TPair<FString, int32>& Pair : ContextSlots)
+    {
+        Total += Pair.Key.GetAllocatedSize();
+    }
+
+    return Total;
+}
+
+void FGameplayEventSearchIndex::FStringIndex::AddString(int32 Key, const FString& String, int32 MinNum)
+{
+    if (Key >= LowerStrings.Num())
+    {
+        const int32 NewNum = FMath::Max(Key + 1, MinNum);
+        LowerStrings.SetNum(NewNum);
+        IndexedKeys.Add(false, NewNum - IndexedKeys.Num());
+        Postings.SetNum(NewNum);
+    }
+
+    if (IndexedKeys[Key])
+    {
+        return;
+    }
+
+    IndexedKeys[Key] = true;
+
+    FString& Lower = LowerStrings[Key];
+    Lower = String.ToLower();
+
+    for (int32 Index = 0; Index + 2 < Lower.Len(); ++Index)
+    {
+        Trigrams.FindOrAdd(MakeTrigramKey(Lower[Index], Lower[Index + 1], Lower[Index + 2])).Add(Key);
+    }
+}
+
+void FGameplayEventSearchIndex::FStringIndex::RemoveString(int32 Key)
+{
+    if (!IndexedKeys.IsValidIndex(Key) || !IndexedKeys[Key])
+    {
+        return;
+    }
+
+    IndexedKeys[Key] = false;
+
+    FString& Lower = LowerStrings[Key];
+    for (int32 Index = 0; Index + 2 < Lower.Len(); ++Index)
+    {
+        const uint64 TrigramKey = MakeTrigramKey(Lower[Index], Lower[Index + 1], Lower[Index + 2]);
+
+        // A window repeated within the string finds its key already gone
+        TSet<int32>* Keys = Trigrams.Find(TrigramKey);
+        if (Keys && Keys->Remove(Key) > 0 && Keys->Num() == 0)
+        {
+            Trigrams.Remove(TrigramKey);
+        }
+    }
+
+    Lower.Empty();
+    Postings[Key].Ids.Empty();
+    Postings[Key].First = 0;
+}
+
+void FGameplayEventSearchIndex::FStringIndex::FindMatchingKeys(const FString& LowerTerm, TArray<int32>& OutKeys) const
+{
+    if (LowerTerm.Len() < 3)
+    {
+        // Too short for trigrams: test every distinct string, which is still far fewer than records
+        for (TConstSetBitIterator<> It(IndexedKeys); It; ++It)
+        {
+            if (LowerStrings[It.GetIndex()].Contains(LowerTerm, ESearchCase::CaseSensitive))
+            {
+                OutKeys.Add(It.GetIndex());
+            }
+        }
+        return;
+    }
+
+    // Start from the rarest trigram of the term to keep the candidate set small
+    const TSet<int32>* Rarest = nullptr;
+    for (int32 Index = 0; Index + 2 < LowerTerm.Len(); ++Index)
+    {
+        const TSet<int32>* List = Trigrams.Find(MakeTrigramKey(LowerTerm[Index], LowerTerm[Index + 1], LowerTerm[Index + 2]));
+        if (!List)
+        {
+            return;
+        }
+
+        if (!Rarest || List->Num() < Rarest->Num())
+        {
+            Rarest = List;
+        }
+    }
+
+    for (const int32 Key : *Rarest)
+    {
+        if (LowerStrings[Key].Contains(LowerTerm, ESearchCase::CaseSensitive))
+        {
+            OutKeys.Add(Key);
+        }
+    }
+}
+
+void FGameplayEventSearchIndex::FStringIndex::ResetPostings()
+{
+    for (FPostingList& List : Postings)
+    {
+        List.Ids.Empty();
+        List.First = 0;
+    }
+}
+
+void FGameplayEventSearchIndex::FStringIndex::Reset()
+{
+    LowerStrings.Empty();
+    IndexedKeys.Empty();
+    Postings.Empty();
+    Trigrams.Empty();
+}
+
+SIZE_T FGameplayEventSearchIndex::FStringIndex::GetAllocatedSize() const
+{
+    SIZE_T Total = LowerStrings.GetAllocatedSize() + IndexedKeys.GetAllocatedSize()
+        + Postings.GetAllocatedSize() + Trigrams.GetAllocatedSize();
+
+    for (const FString& String : LowerStrings)
+    {
+        Total += String.GetAllocatedSize();
+    }
+
+    for (const FPostingList& List : Postings)
+    {
+        Total += List.Ids.GetAllocatedSize();
+    }
+
+    for (const TPair<uint64, TSet<int32>>& Pair : Trigrams)
+    {
+        Total += Pair.Value.GetAllocatedSize();
+    }
+
+    return Total;
+}
+
+uint64 FGameplayEventSearchIndex::MakeTrigramKey(TCHAR A, TCHAR B, TCHAR C)
+{
+    // 21 bits per character covers every Unicode code point
+    constexpr uint64 Mask = 0x1FFFFF;
+    return ((static_cast<uint64>(A) & Mask) << 42) | ((static_cast<uint64>(B) & Mask) << 21) | (static_cast<uint64>(C) & Mask);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventStringTable.h"
+
+struct FGameplayEventRecord;
+
+/** Which record field a search runs against. */
+enum class EGameplayEventSearchField : uint8
+{
+    Name,
+    Context
+};
+
+/**
+ * FGameplayEventSearchIndex
+ * -------------------------
+ * Incrementally maintained search index over the logger's records.
+ *
+ * - Every distinct string is lowercased once when first indexed. Names are keyed by their
+ *   string table handle; contexts are not interned, so the index gives each distinct
+ *   context a slot of its own, freed with the last record using it.
+ * - Per string, a posting list holds the stable ids of records using it. Ids are removed
+ *   as their records are evicted, so postings cost 16 bytes per stored record.
+ * - A trigram index maps each lowercase 3-character window to the strings containing it,
+ *   so substring queries of 3+ characters only verify a few candidate strings.
+ *
+ * Queries never touch individual records and never allocate per record; cost is driven by
+ * the number of distinct strings tested and the number of matching records returned.
+ * Not thread-safe; the logger guards it with its mutex.
+ */
+class YOURPROJECT_API FGameplayEventSearchIndex
+{
+public:
+    /** Indexes a newly stored record that received stable id RecordId. */
+    void Add(const FGameplayEventRecord& Record, uint64 RecordId, const FGameplayEventStringTable& Strings);
+
+    /** Removes an evicted record. Records must be removed oldest first, in the order they were added. */
+    void Remove(const FGameplayEventRecord& Record, uint64 RecordId);
+
+    /** Appends to OutRecordIds the ids (ascending) of records whose field contains SearchTerm, ignoring case. */
+    void Query(const FString& SearchTerm, EGameplayEventSearchField Field, TArray<uint64>& OutRecordIds) const;
+
+    /** Drops all postings. Lowercased names and their trigrams are kept since handles stay valid. */
+    void ResetPostings();
+
+    /** Drops everything, including lowercased strings and trigrams. */
+    void Reset();
+
+    /** Bytes held by the index. */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** Ascending ids of the records using one string. Ids before First are evicted and compacted away in bulk. */
+    struct FPostingList
+    {
+        TArray<uint64> Ids;
+        int32 First = 0;
+
+        int32 Num() const { return Ids.Num() - First; }
+    };
+
+    /** Lowercased strings, trigrams and postings of one searchable field, keyed by small integers. */
+    struct FStringIndex
+    {
+        /** Lowercased strings by key; unindexed keys are marked in IndexedKeys. */
+        TArray<FString> LowerStrings;
+        TBitArray<> IndexedKeys;
+
+        /** Record ids per key. */
+        TArray<FPostingList> Postings;
+
+        /** Trigram -> keys containing it. A set, so evicting a context does not scan every string sharing a trigram. */
+        TMap<uint64, TSet<int32>> Trigrams;
+
+        /** Lowercases and trigram-indexes String under Key the first time Key is seen. MinNum presizes the arrays. */
+        void AddString(int32 Key, const FString& String, int32 MinNum);
+
+        /** Forgets the string under Key and its trigrams, leaving Key free for another string. */
+        void RemoveString(int32 Key);
+
+        /** Collects the keys whose lowercase string contains LowerTerm. */
+        void FindMatchingKeys(const FString& LowerTerm, TArray<int32>& OutKeys) const;
+
+        void ResetPostings();
+        void Reset();
+        SIZE_T GetAllocatedSize() const;
+    };
+
+    /** Drops RecordId from the front of List. */
+    static void RemoveOldest(FPostingList& List, uint64 RecordId);
+
+    /** Packs three lowercase characters into one trigram key. */
+    static uint64 MakeTrigramKey(TCHAR A, TCHAR B, TCHAR C);
+
+    /** Names, keyed by string table handle. */
+    FStringIndex Names;
+
+    /** Contexts of stored records, keyed by the slots in ContextSlots. Compared case-sensitively like interned strings. */
+    FStringIndex Contexts;
+    TMap<FString, int32, FDefaultSetAllocator, FGameplayEventStringTable::FCaseSensitiveKeyFuncs> ContextSlots;
+
+    /** Slots whose context left the log, reused before Contexts grows. */
+    TArray<int32> FreeContextSlots;
+};
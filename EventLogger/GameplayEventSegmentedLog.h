@@ -0,0 +1,326 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-size block of items shared between TGameplayEventSegmentedLog and its snapshots.
+ * Slots are written once and never modified afterwards, so readers holding a reference
+ * can read the slots that existed when they took it without any lock.
+ */
+template <typename ElementType, int32 SegmentSize>
+struct TGameplayEventLogSegment
+{
+    TGameplayEventLogSegment()
+    {
+        Items.SetNum(SegmentSize);
+    }
+
+    TArray<ElementType> Items;
+};
+
+/**
+ * TGameplayEventLogSnapshot
+ * -------------------------
+ * Immutable, zero-copy view of a TGameplayEventSegmentedLog at the moment it was taken.
+ * Holds references to the log's segments, so it stays valid and consistent while the log
+ * keeps appending or evicting, and may be read from any thread without locking.
+ */
+template <typename ElementType, int32 SegmentSize = 4096>
+class TGameplayEventLogSnapshot
+{
+public:
+    using FSegment = TGameplayEventLogSegment<ElementType, SegmentSize>;
+    using FSegmentRef = TSharedPtr<FSegment, ESPMode::ThreadSafe>;
+
+    TGameplayEventLogSnapshot() = default;
+
+    TGameplayEventLogSnapshot(TArray<FSegmentRef> InSegments, int32 InHeadOffset, int32 InCount, uint64 InFirstId)
+        : Segments(MoveTemp(InSegments)), HeadOffset(InHeadOffset), Count(InCount), FirstId(InFirstId)
+    {
+    }
+
+    int32 Num() const { return Count; }
+    uint64 GetFirstId() const { return FirstId; }
+
+    const ElementType& operator[](int32 Index) const
+    {
+        check(Index >= 0 && Index < Count);
+        const int32 Slot = HeadOffset + Index;
+        return Segments[Slot / SegmentSize]->Items.GetData()[Slot % SegmentSize];
+    }
+
+    /** Calls Visitor with each contiguous run of items, oldest first. Fastest way to stream a snapshot. */
+    template <typename VisitorType>
+    void ForEachRun(VisitorType&& Visitor) const
+    {
+        int32 Remaining = Count;
+        int32 Offset = HeadOffset;
+
+        for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num() && Remaining > 0; ++SegmentIndex)
+        {
+            const int32 RunLength = FMath::Min(SegmentSize - Offset, Remaining);
+            Visitor(TArrayView<const ElementType>(Segments[SegmentIndex]->Items.GetData() + Offset, RunLength));
+            Remaining -= RunLength;
+            Offset = 0;
+        }
+    }
+
+    class FConstIterator
+    {
+    public:
+        FConstIterator(const TGameplayEventLogSnapshot& InSnapshot, int32 InIndex) : Snapshot(InSnapshot), Index(InIndex) {}
+
+        const ElementType& operator*() const { return Snapshot[Index]; }
+        FConstIterator& operator++() { ++Index; return *this; }
+        bool operator!=(const FConstIterator& Other) const { return Index != Other.Index; }
+
+    private:
+        const TGameplayEventLogSnapshot& Snapshot;
+        int32 Index;
+    };
+
+    FConstIterator begin() const { return FConstIterator(*this, 0); }
+    FConstIterator end() const { return FConstIterator(*this, Count); }
+
+private:
+    TArray<FSegmentRef> Segments;
+    int32 HeadOffset = 0;
+    int32 Count = 0;
+    uint64 FirstId = 0;
+};
+
+/**
+ * TGameplayEventSegmentedLog
+ * --------------------------
+ * Append-ordered event storage used by UGameplayEventLogger, built from fixed-size,
+ * reference-counted segments.
+ *
+ * - Items are appended into the tail segment and never moved or modified afterwards,
+ *   so MakeSnapshot() only copies segment references and readers need no lock.
+ * - With a capacity of 0 the log grows without limit. With a positive capacity Add returns
+ *   false when full and the caller decides whether to drop the new item or make room with
+ *   PopOldest. Segments are allocated when the first item lands in them; segments that drain
+ *   out of the head are recycled unless a snapshot still holds them, so a bounded log stops
+ *   allocating once it has filled up and an empty log costs no segment at all.
+ * - Logical index 0 is always the oldest item. Every item also gets a stable id that keeps
+ *   increasing across evictions, so indexes built on top of the log can refer to items
+ *   without being rewritten when the oldest ones are dropped.
+ *
+ * Not thread-safe for writers; the logger guards it with its mutex. Snapshots are thread-safe.
+ */
+template <typename ElementType, int32 SegmentSize = 4096>
+class TGameplayEventSegmentedLog
+{
+public:
+    using FSnapshot = TGameplayEventLogSnapshot<ElementType, SegmentSize>;
+    using FSegment = typename FSnapshot::FSegment;
+    using FSegmentRef = typename FSnapshot::FSegmentRef;
+
+    /** Sets the maximum number of items (0 = unbounded). Keeps the newest items that fit. Returns how many were discarded. */
+    int32 SetCapacity(int32 NewCapacity)
+    {
+        Capacity = FMath::Max(NewCapacity, 0);
+
+        const int32 NumDiscarded = Capacity > 0 ? FMath::Max(Count - Capacity, 0) : 0;
+        PopOldest(NumDiscarded);
+
+        // A smaller capacity needs fewer spares
+        const int32 MaxFreeSegments = FMath::Max(GetPooledSegmentLimit() - Segments.Num(), 0);
+        if (FreeSegments.Num() > MaxFreeSegments)
+        {
+            FreeSegments.SetNum(MaxFreeSegments);
+        }
+
+        return NumDiscarded;
+    }
+
+    /** Appends an item. Returns false, leaving the log untouched, when a bounded log is full. */
+    bool Add(const ElementType& Item)
+    {
+        ElementType* Slot = AddSlot();
+        if (!Slot)
+        {
+            return false;
+        }
+
+        *Slot = Item;
+        return true;
+    }
+
+    /** Moves an item in. Returns false, leaving Item untouched, when a bounded log is full. */
+    bool Add(ElementType&& Item)
+    {
+        ElementType* Slot = AddSlot();
+        if (!Slot)
+        {
+            return false;
+        }
+
+        *Slot = MoveTemp(Item);
+        return true;
+    }
+
+    /** Removes up to NumToPop of the oldest items, passing each to Sink before removal. Returns the number removed. */
+    template <typename SinkType>
+    int32 PopOldest(int32 NumToPop, SinkType&& Sink)
+    {
+        NumToPop = FMath::Clamp(NumToPop, 0, Count);
+
+        for (int32 Index = 0; Index < NumToPop; ++Index)
+        {
+            Sink((*this)[Index]);
+        }
+
+        HeadOffset += NumToPop;
+        Count -= NumToPop;
+        FirstId += NumToPop;
+
+        while (HeadOffset >= SegmentSize)
+        {
+            ReleaseSegment(Segments[0]);
+            Segments.RemoveAt(0, 1, false);
+            HeadOffset -= SegmentSize;
+        }
+
+        return NumToPop;
+    }
+
+    int32 PopOldest(int32 NumToPop)
+    {
+        return PopOldest(NumToPop, [](const ElementType&) {});
+    }
+
+    /** Removes every item. Segments go back to the free list when no snapshot holds them. */
+    void Reset()
+    {
+        for (FSegmentRef& Segment : Segments)
+        {
+            ReleaseSegment(Segment);
+        }
+
+        Segments.Reset();
+        FirstId += Count;
+        HeadOffset = 0;
+        Count = 0;
+    }
+
+    /** Makes sure NumElements more items, or as many as a bounded log still has room for, can be added without allocating a segment. */
+    void Reserve(int32 NumElements)
+    {
+        if (Capacity > 0)
+        {
+            NumElements = FMath::Min(NumElements, Capacity - Count);
+        }
+
+        const int32 SlotsAvailable = Segments.Num() * SegmentSize - (HeadOffset + Count) + FreeSegments.Num() * SegmentSize;
+        for (int32 Missing = NumElements - SlotsAvailable; Missing > 0; Missing -= SegmentSize)
+        {
+            FreeSegments.Add(MakeShared<FSegment, ESPMode::ThreadSafe>());
+        }
+    }
+
+    /** Returns an immutable view of the current contents. Only copies segment references. */
+    FSnapshot MakeSnapshot() const
+    {
+        return FSnapshot(Segments, HeadOffset, Count, FirstId);
+    }
+
+    /** Stable id of the oldest item. Ids of stored items are FirstId .. FirstId + Num() - 1. */
+    uint64 GetFirstId() const { return FirstId; }
+
+    /** Id that the next added item will get. */
+    uint64 GetNextId() const { return FirstId + Count; }
+
+    /** Converts a stable id back to a logical index, INDEX_NONE if it was evicted or not added yet. */
+    int32 IndexOfId(uint64 Id) const
+    {
+        return Id >= FirstId && Id < FirstId + Count ? static_cast<int32>(Id - FirstId) : INDEX_NONE;
+    }
+
+    int32 Num() const { return Count; }
+    int32 GetCapacity() const { return Capacity; }
+    bool IsFull() const { return Capacity > 0 && Count == Capacity; }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return (Segments.Num() + FreeSegments.Num()) * (sizeof(FSegment) + SegmentSize * sizeof(ElementType))
+            + Segments.GetAllocatedSize() + FreeSegments.GetAllocatedSize();
+    }
+
+    const ElementType& operator[](int32 Index) const
+    {
+        const int32 Slot = HeadOffset + Index;
+        return Segments[Slot / SegmentSize]->Items[Slot % SegmentSize];
+    }
+
+    /** Forward iterator in logical (oldest to newest) order. */
+    class FConstIterator
+    {
+    public:
+        FConstIterator(const TGameplayEventSegmentedLog& InLog, int32 InIndex) : Log(InLog), Index(InIndex) {}
+
+        const ElementType& operator*() const { return Log[Index]; }
+        FConstIterator& operator++() { ++Index; return *this; }
+        bool operator!=(const FConstIterator& Other) const { return Index != Other.Index; }
+
+    private:
+        const TGameplayEventSegmentedLog& Log;
+        int32 Index;
+    };
+
+    FConstIterator begin() const { return FConstIterator(*this, 0); }
+    FConstIterator end() const { return FConstIterator(*this, Count); }
+
+private:
+    /** Claims the slot after the newest item, null when a bounded log is full. */
+    ElementType* AddSlot()
+    {
+        if (IsFull())
+        {
+            return nullptr;
+        }
+
+        const int32 Slot = HeadOffset + Count;
+        if (Slot / SegmentSize >= Segments.Num())
+        {
+            Segments.Add(AcquireSegment());
+        }
+
+        ++Count;
+        return &Segments[Slot / SegmentSize]->Items[Slot % SegmentSize];
+    }
+
+    FSegmentRef AcquireSegment()
+    {
+        return FreeSegments.Num() > 0 ? FreeSegments.Pop(false) : MakeShared<FSegment, ESPMode::ThreadSafe>();
+    }
+
+    void ReleaseSegment(FSegmentRef& Segment)
+    {
+        // A segment still referenced by a snapshot is left to it; the snapshot frees it later
+        if (Segment.IsUnique() && FreeSegments.Num() < GetPooledSegmentLimit())
+        {
+            FreeSegments.Add(MoveTemp(Segment));
+        }
+        Segment.Reset();
+    }
+
+    /** Segments worth keeping around: a full bounded log (which can straddle one extra segment), or a small spare pool. */
+    int32 GetPooledSegmentLimit() const
+    {
+        return Capacity > 0 ? (Capacity + SegmentSize - 1) / SegmentSize + 1 : 2;
+    }
+
+    /** Live segments, oldest first. All but the last are full. */
+    TArray<FSegmentRef> Segments;
+
+    /** Recycled segments ready for reuse. */
+    TArray<FSegmentRef> FreeSegments;
+
+    /** Slot of the oldest item within Segments[0]. */
+    int32 HeadOffset = 0;
+
+    int32 Count = 0;
+    int32 Capacity = 0;
+    uint64 FirstId = 0;
+};
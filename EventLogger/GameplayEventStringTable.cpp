@@ -0,0 +1,148 @@
+#include "GameplayEventStringTable.h"
+
+namespace GameplayEventStringTablePrivate
+{
+    /** A thread usually logs into one or two tables; older entries are replaced round-robin. */
+    constexpr int32 CacheSize = 4;
+
+    /** Strings cached per table and thread. A thread cycling through more names starts over rather than growing. */
+    constexpr int32 MaxCachedStrings = 64;
+
+    struct FCacheEntry
+    {
+        uint64 Serial = 0;
+        TMap<FString, int32, FDefaultSetAllocator, FGameplayEventStringTable::FCaseSensitiveKeyFuncs> Handles;
+    };
+
+    thread_local FCacheEntry Cache[CacheSize];
+    thread_local int32 NextCacheSlot = 0;
+
+    std::atomic<uint64> NextSerial{ 1 };
+}
+
+FGameplayEventStringTable::FGameplayEventStringTable()
+{
+    Reset();
+}
+
+int32 FGameplayEventStringTable::Intern(const FString& Value)
+{
+    if (Value.IsEmpty())
+    {
+        return EmptyHandle;
+    }
+
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const int32* Existing = Lookup.Find(Value))
+        {
+            return *Existing;
+        }
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+
+    // Another thread may have added it between the two locks
+    if (const int32* Existing = Lookup.Find(Value))
+    {
+        return *Existing;
+    }
+
+    const int32 Handle = Strings.Add(MakeUnique<FString>(Value));
+    Lookup.Add(Value, Handle);
+    return Handle;
+}
+
+int32 FGameplayEventStringTable::InternCached(const FString& Value)
+{
+    using namespace GameplayEventStringTablePrivate;
+
+    if (Value.IsEmpty())
+    {
+        return EmptyHandle;
+    }
+
+    // Read before interning: if Reset runs in between, the handle is filed under the old serial and never matches again
+    const uint64 CurrentSerial = Serial.load(std::memory_order_acquire);
+
+    FCacheEntry* Entry = nullptr;
+    for (FCacheEntry& Candidate : Cache)
+    {
+        if (Candidate.Serial == CurrentSerial)
+        {
+            Entry = &Candidate;
+            break;
+        }
+    }
+
+    if (Entry)
+    {
+        if (const int32* Cached = Entry->Handles.Find(Value))
+        {
+            return *Cached;
+        }
+    }
+    else
+    {
+        Entry = &Cache[NextCacheSlot];
+        NextCacheSlot = (NextCacheSlot + 1) % CacheSize;
+        Entry->Serial = CurrentSerial;
+        Entry->Handles.Reset();
+    }
+
+    const int32 Handle = Intern(Value);
+
+    if (Entry->Handles.Num() >= MaxCachedStrings)
+    {
+        Entry->Handles.Reset();
+    }
+    Entry->Handles.Add(Value, Handle);
+    return Handle;
+}
+
+int32 FGameplayEventStringTable::Find(const FString& Value) const
+{
+    if (Value.IsEmpty())
+    {
+        return EmptyHandle;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const int32* Existing = Lookup.Find(Value);
+    return Existing ? *Existing : INDEX_NONE;
+}
+
+const FString& FGameplayEventStringTable::Resolve(int32 Handle) const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Strings.IsValidIndex(Handle) ? *Strings[Handle] : *Strings[EmptyHandle];
+}
+
+int32 FGameplayEventStringTable::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Strings.Num();
+}
+
+SIZE_T FGameplayEventStringTable::GetAllocatedSize() const
+{
+    FReadScopeLock ReadLock(Lock);
+
+    SIZE_T Total = Strings.GetAllocatedSize() + Lookup.GetAllocatedSize();
+    for (const TUniquePtr<FString>& String : Strings)
+    {
+        // Each string is held twice: once boxed for Resolve, once as the lookup key
+        Total += sizeof(FString) + String->GetAllocatedSize() * 2;
+    }
+    return Total;
+}
+
+void FGameplayEventStringTable::Reset()
+{
+    FWriteScopeLock WriteLock(Lock);
+
+    Strings.Reset();
+    Lookup.Reset();
+    Strings.Add(MakeUnique<FString>());
+    Serial.store(GameplayEventStringTablePrivate::NextSerial.fetch_add(1, std::memory_order_relaxed), std::memory_order_release);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+/**
+ * FGameplayEventStringTable
+ * -------------------------
+ * Thread-safe string pool that maps event names and owners to stable integer handles.
+ * Each distinct string is stored once, so event records only carry int32 handles.
+ *
+ * Handle 0 is always the empty string. Handles are never recycled while the table lives,
+ * and resolved references stay valid until Reset() is called. The pool only grows between
+ * resets, whatever the capacity of the log using it.
+ */
+class YOURPROJECT_API FGameplayEventStringTable
+{
+public:
+    static constexpr int32 EmptyHandle = 0;
+
+    /**
+     * Case-sensitive key funcs for TMap<FString, int32>: the default FString hash/compare ignore case,
+     * which would merge "Hit" and "hit". Also used wherever strings of two tables are matched up.
+     */
+    struct FCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+    {
+        static FORCEINLINE bool Matches(const FString& A, const FString& B)
+        {
+            return A.Equals(B, ESearchCase::CaseSensitive);
+        }
+
+        static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+        {
+            return FCrc::StrCrc32(*Key);
+        }
+    };
+
+    FGameplayEventStringTable();
+
+    FGameplayEventStringTable(const FGameplayEventStringTable&) = delete;
+    FGameplayEventStringTable& operator=(const FGameplayEventStringTable&) = delete;
+
+    /** Returns the handle for the given string, adding it to the pool if needed. Thread-safe. */
+    int32 Intern(const FString& Value);
+
+    /**
+     * Intern through a small per-thread cache of recently used strings, so a thread logging the
+     * same few event names does not take the shared lock on every event. Thread-safe.
+     */
+    int32 InternCached(const FString& Value);
+
+    /** Returns the handle for the string if it was interned before, INDEX_NONE otherwise. Thread-safe. */
+    int32 Find(const FString& Value) const;
+
+    /** Resolves a handle back to its string. Invalid handles resolve to the empty string. Thread-safe. */
+    const FString& Resolve(int32 Handle) const;
+
+    /** Number of distinct strings in the pool, including the empty string. */
+    int32 Num() const;
+
+    /** Bytes held by the pool (strings plus lookup table). */
+    SIZE_T GetAllocatedSize() const;
+
+    /** Drops every string except the empty one. Any outstanding handle, cached ones included, becomes invalid. */
+    void Reset();
+
+private:
+    /** Identifies this table's contents in the per-thread caches; a new value on every Reset, never reused by another table. */
+    std::atomic<uint64> Serial{ 0 };
+
+    mutable FRWLock Lock;
+
+    /** Owned strings; boxed so references returned by Resolve survive array growth. */
+    TArray<TUniquePtr<FString>> Strings;
+
+    TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> Lookup;
+};
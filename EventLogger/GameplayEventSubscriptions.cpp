@@ -0,0 +1,176 @@
+#include "GameplayEventSubscriptions.h"
+#include "GameplayEventLogger.h"
+#include "GameplayEventSchema.h"
+#include "GameplayEventStringTable.h"
+
+struct FGameplayEventSubscriptions::FSubscription
+{
+    int32 Id = 0;
+    TArray<int32> NameIds;
+    TArray<FName> Categories;
+    int32 OwnerId = INDEX_NONE;
+    FPredicate Predicate;
+    FCallback Callback;
+
+    /** Cleared by Remove, so a batch already taken by Dispatch is not delivered. */
+    bool bActive = true;
+
+    /** Events matched since the last dispatch. */
+    TArray<FGameplayEventPendingRecord> Pending;
+
+    bool WantsEveryName() const { return NameIds.Num() == 0 && Categories.Num() == 0; }
+};
+
+FGameplayEventSubscriptions::FGameplayEventSubscriptions()
+{
+}
+
+FGameplayEventSubscriptions::~FGameplayEventSubscriptions() = default;
+
+int32 FGameplayEventSubscriptions::Add(TArray<int32> NameIds, TArray<FName> Categories, int32 OwnerId, FPredicate Predicate, FCallback Callback)
+{
+    TSharedRef<FSubscription> Subscription = MakeShared<FSubscription>();
+    Subscription->NameIds = MoveTemp(NameIds);
+    Subscription->Categories = MoveTemp(Categories);
+    Subscription->OwnerId = OwnerId;
+    Subscription->Predicate = MoveTemp(Predicate);
+    Subscription->Callback = MoveTemp(Callback);
+
+    FScopeLock Lock(&Mutex);
+    Subscription->Id = NextId++;
+    Subscriptions.Add(Subscription);
+    InvalidateNames_Locked();
+
+    NumSubscriptions.store(Subscriptions.Num(), std::memory_order_relaxed);
+    return Subscription->Id;
+}
+
+bool FGameplayEventSubscriptions::Remove(int32 SubscriptionId)
+{
+    FScopeLock Lock(&Mutex);
+
+    const int32 Index = Subscriptions.IndexOfByPredicate([SubscriptionId](const TSharedRef<FSubscription>& Subscription)
+    {
+        return Subscription->Id == SubscriptionId;
+    });
+
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Subscriptions[Index]->bActive = false;
+    Subscriptions.RemoveAt(Index);
+    InvalidateNames_Locked();
+
+    NumSubscriptions.store(Subscriptions.Num(), std::memory_order_relaxed);
+    return true;
+}
+
+void FGameplayEventSubscriptions::Match(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields, const FGameplayEventStringTable& Strings)
+{
+    if (!HasAny())
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+
+    for (const int32 Index : GetSubscribersOfName_Locked(Record.NameId, Strings))
+    {
+        FSubscription& Subscription = *Subscriptions[Index];
+
+        if (Subscription.OwnerId != INDEX_NONE && Subscription.OwnerId != Record.OwnerId)
+        {
+            continue;
+        }
+
+        if (Subscription.Predicate && !Subscription.Predicate(Record, Fields))
+        {
+            continue;
+        }
+
+        Subscription.Pending.Add(FGameplayEventPendingRecord{ Record, TArray<FGameplayEventField>(Fields) });
+    }
+}
+
+void FGameplayEventSubscriptions::Dispatch(const FGameplayEventStringTable& Strings)
+{
+    if (!HasAny())
+    {
+        return;
+    }
+
+    TArray<TPair<TSharedRef<FSubscription>, TArray<FGameplayEventPendingRecord>>> Batches;
+    {
+        FScopeLock Lock(&Mutex);
+
+        for (const TSharedRef<FSubscription>& Subscription : Subscriptions)
+        {
+            if (Subscription->Pending.Num() > 0)
+            {
+                Batches.Emplace(Subscription, MoveTemp(Subscription->Pending));
+            }
+        }
+    }
+
+    // Unlocked, so callbacks may log, query, subscribe or unsubscribe
+    for (const TPair<TSharedRef<FSubscription>, TArray<FGameplayEventPendingRecord>>& Batch : Batches)
+    {
+        if (Batch.Key->bActive)
+        {
+            Batch.Key->Callback(Batch.Value, Strings);
+        }
+    }
+}
+
+const TArray<int32>& FGameplayEventSubscriptions::GetSubscribersOfName_Locked(int32 NameId, const FGameplayEventStringTable& Strings)
+{
+    check(NameId >= 0);
+
+    if (NameId >= SubscribersByName.Num())
+    {
+        SubscribersByName.SetNum(NameId + 1);
+        ResolvedNames.Add(false, NameId + 1 - ResolvedNames.Num());
+    }
+
+    TArray<int32>& Subscribers = SubscribersByName[NameId];
+    if (ResolvedNames[NameId])
+    {
+        return Subscribers;
+    }
+
+    // Looked up at most once per name, and only if some subscription filters by category
+    const FGameplayEventSchemaInfo* Schema = nullptr;
+    bool bSchemaLookedUp = false;
+
+    Subscribers.Reset();
+    for (int32 Index = 0; Index < Subscriptions.Num(); ++Index)
+    {
+        const FSubscription& Subscription = *Subscriptions[Index];
+        bool bWantsName = Subscription.WantsEveryName() || Subscription.NameIds.Contains(NameId);
+
+        if (!bWantsName && Subscription.Categories.Num() > 0)
+        {
+            if (!bSchemaLookedUp)
+            {
+                Schema = FGameplayEventSchemaRegistry::FindByName(Strings.Resolve(NameId));
+                bSchemaLookedUp = true;
+            }
+            bWantsName = Schema && Subscription.Categories.Contains(Schema->Category);
+        }
+
+        if (bWantsName)
+        {
+            Subscribers.Add(Index);
+        }
+    }
+
+    ResolvedNames[NameId] = true;
+    return Subscribers;
+}
+
+void FGameplayEventSubscriptions::InvalidateNames_Locked()
+{
+    ResolvedNames.Init(false, ResolvedNames.Num());
+}
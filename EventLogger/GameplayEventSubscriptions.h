@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FGameplayEventStringTable;
+struct FGameplayEventField;
+struct FGameplayEventPendingRecord;
+struct FGameplayEventRecord;
+
+/**
+ * FGameplayEventSubscriptions
+ * ---------------------------
+ * Listeners for newly stored events, matched by interned name handle and delivered in batches.
+ *
+ * A subscription asks for exact names, categories of declared event types, or everything,
+ * optionally narrowed to one owner and by a predicate. The subscriptions interested in a name
+ * handle are resolved the first time the handle is stored and cached in a table indexed by
+ * handle, so matching costs one lookup plus the work for subscriptions of that name; events
+ * nobody asked for cost nothing more. Matched events are copied into per-subscription batches
+ * that Dispatch hands to the callbacks, outside any lock.
+ *
+ * Match may run on any thread that stores events; Add, Remove and Dispatch are meant for the
+ * game thread.
+ */
+class YOURPROJECT_API FGameplayEventSubscriptions
+{
+public:
+    /** Extra filter run on events whose name matched. Runs with the logger locked; must not call back into it. */
+    using FPredicate = TFunction<bool(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields)>;
+
+    /** Receives the events matched since the previous dispatch, oldest first. Strings resolves their handles. */
+    using FCallback = TFunction<void(TArrayView<const FGameplayEventPendingRecord> Events, const FGameplayEventStringTable& Strings)>;
+
+    FGameplayEventSubscriptions();
+    ~FGameplayEventSubscriptions();
+
+    /**
+     * Registers a subscription and returns its id (never 0). Empty NameIds and Categories receive
+     * every event; OwnerId other than INDEX_NONE only receives events stamped with that owner.
+     */
+    int32 Add(TArray<int32> NameIds, TArray<FName> Categories, int32 OwnerId, FPredicate Predicate, FCallback Callback);
+
+    /** Removes a subscription. Its undelivered events are discarded. Returns false for an unknown id. */
+    bool Remove(int32 SubscriptionId);
+
+    bool HasAny() const { return NumSubscriptions.load(std::memory_order_relaxed) > 0; }
+
+    /** Copies Record into the batch of every subscription it matches. */
+    void Match(const FGameplayEventRecord& Record, TArrayView<const FGameplayEventField> Fields, const FGameplayEventStringTable& Strings);
+
+    /** Hands every non-empty batch to its callback. */
+    void Dispatch(const FGameplayEventStringTable& Strings);
+
+private:
+    struct FSubscription;
+
+    /** Returns the indices into Subscriptions interested in NameId, resolving them on first use. Caller must hold Mutex. */
+    const TArray<int32>& GetSubscribersOfName_Locked(int32 NameId, const FGameplayEventStringTable& Strings);
+
+    /** Forgets every resolved name; called when the set of subscriptions changes. Caller must hold Mutex. */
+    void InvalidateNames_Locked();
+
+    FCriticalSection Mutex;
+
+    /** Shared so Dispatch can keep a subscription alive while a callback removes it. */
+    TArray<TSharedRef<FSubscription>> Subscriptions;
+
+    /** Subscription indices per name handle; valid where ResolvedNames is set. */
+    TArray<TArray<int32>> SubscribersByName;
+    TBitArray<> ResolvedNames;
+
+    int32 NextId = 1;
+
+    /** Lets Match skip the lock while nobody is subscribed. */
+    std::atomic<int32> NumSubscriptions{ 0 };
+};
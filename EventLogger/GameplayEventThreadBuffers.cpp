@@ -0,0 +1,168 @@
+#include "GameplayEventThreadBuffers.h"
+#include "GameplayEventLogger.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+
+struct FGameplayEventThreadBuffers::FThreadBuffer
+{
+    FThreadBuffer(uint32 InThreadId, uint32 Capacity)
+        : ThreadId(InThreadId), Events(Capacity)
+    {
+    }
+
+    uint32 ThreadId;
+    TGameplayEventRingBuffer<FGameplayEventPendingRecord> Events;
+};
+
+namespace GameplayEventThreadBuffersPrivate
+{
+    /** A thread usually logs into one or two loggers; older entries are replaced round-robin. */
+    constexpr int32 CacheSize = 4;
+
+    struct FCacheEntry
+    {
+        uint64 Serial = 0;
+        void* Buffer = nullptr;
+    };
+
+    thread_local FCacheEntry Cache[CacheSize];
+    thread_local int32 NextCacheSlot = 0;
+
+    std::atomic<uint64> NextSerial{ 1 };
+}
+
+FGameplayEventThreadBuffers::FGameplayEventThreadBuffers(uint32 InCapacityPerThread)
+    : Serial(GameplayEventThreadBuffersPrivate::NextSerial.fetch_add(1, std::memory_order_relaxed))
+    , CapacityPerThread(FMath::Max<uint32>(InCapacityPerThread, 2))
+{
+}
+
+FGameplayEventThreadBuffers::~FGameplayEventThreadBuffers() = default;
+
+bool FGameplayEventThreadBuffers::TryEnqueue(FGameplayEventPendingRecord&& Item)
+{
+    using namespace GameplayEventThreadBuffersPrivate;
+
+    for (const FCacheEntry& Entry : Cache)
+    {
+        if (Entry.Serial == Serial)
+        {
+            return static_cast<FThreadBuffer*>(Entry.Buffer)->Events.TryEnqueue(MoveTemp(Item));
+        }
+    }
+
+    return FindOrAddThreadBuffer().Events.TryEnqueue(MoveTemp(Item));
+}
+
+FGameplayEventThreadBuffers::FThreadBuffer& FGameplayEventThreadBuffers::FindOrAddThreadBuffer()
+{
+    using namespace GameplayEventThreadBuffersPrivate;
+
+    const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+    FThreadBuffer* Buffer = nullptr;
+    {
+        FScopeLock Lock(&BuffersMutex);
+
+        // The thread may have been evicted from its cache while its ring still exists
+        for (const TUniquePtr<FThreadBuffer>& Existing : Buffers)
+        {
+            if (Existing->ThreadId == ThreadId)
+            {
+                Buffer = Existing.Get();
+                break;
+            }
+        }
+
+        if (!Buffer)
+        {
+            Buffer = Buffers.Add_GetRef(MakeUnique<FThreadBuffer>(ThreadId, CapacityPerThread)).Get();
+        }
+    }
+
+    FCacheEntry& Entry = Cache[NextCacheSlot];
+    NextCacheSlot = (NextCacheSlot + 1) % CacheSize;
+    Entry.Serial = Serial;
+    Entry.Buffer = Buffer;
+    return *Buffer;
+}
+
+int32 FGameplayEventThreadBuffers::DrainMerged(TFunctionRef<void(FGameplayEventPendingRecord&& Item)> Sink)
+{
+    MergeScratch.Reset();
+    RunEnds.Reset();
+    {
+        FScopeLock Lock(&BuffersMutex);
+        for (const TUniquePtr<FThreadBuffer>& Buffer : Buffers)
+        {
+            if (Buffer->Events.Drain([this](FGameplayEventPendingRecord&& Item) { MergeScratch.Add(MoveTemp(Item)); }) > 0)
+            {
+                RunEnds.Add(MergeScratch.Num());
+            }
+        }
+    }
+
+    // Each run is already ordered by its producer; a single run needs no merge
+    if (RunEnds.Num() <= 1)
+    {
+        for (FGameplayEventPendingRecord& Item : MergeScratch)
+        {
+            Sink(MoveTemp(Item));
+        }
+        return MergeScratch.Num();
+    }
+
+    struct FCursor
+    {
+        int32 Index;
+        int32 End;
+    };
+
+    // Sequence numbers, when replay capture assigns them, are the authoritative order; cycles otherwise
+    auto IsEarlier = [this](const FCursor& A, const FCursor& B)
+    {
+        const FGameplayEventRecord& RecordA = MergeScratch[A.Index].Record;
+        const FGameplayEventRecord& RecordB = MergeScratch[B.Index].Record;
+        return RecordA.Sequence != RecordB.Sequence ? RecordA.Sequence < RecordB.Sequence : RecordA.Cycles < RecordB.Cycles;
+    };
+
+    TArray<FCursor, TInlineAllocator<16>> Heap;
+    int32 RunStart = 0;
+    for (const int32 RunEnd : RunEnds)
+    {
+        Heap.Add({ RunStart, RunEnd });
+        RunStart = RunEnd;
+    }
+    Heap.Heapify(IsEarlier);
+
+    while (Heap.Num() > 0)
+    {
+        FCursor Cursor;
+        Heap.HeapPop(Cursor, IsEarlier, false);
+        Sink(MoveTemp(MergeScratch[Cursor.Index]));
+
+        if (++Cursor.Index < Cursor.End)
+        {
+            Heap.HeapPush(Cursor, IsEarlier);
+        }
+    }
+
+    return MergeScratch.Num();
+}
+
+int32 FGameplayEventThreadBuffers::GetApproximateNum() const
+{
+    FScopeLock Lock(&BuffersMutex);
+
+    int32 Total = 0;
+    for (const TUniquePtr<FThreadBuffer>& Buffer : Buffers)
+    {
+        Total += static_cast<int32>(Buffer->Events.GetApproximateNum());
+    }
+    return Total;
+}
+
+int32 FGameplayEventThreadBuffers::GetNumThreads() const
+{
+    FScopeLock Lock(&BuffersMutex);
+    return Buffers.Num();
+}
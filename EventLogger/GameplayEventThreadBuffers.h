@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEventRingBuffer.h"
+
+struct FGameplayEventPendingRecord;
+
+/**
+ * FGameplayEventThreadBuffers
+ * ---------------------------
+ * One lock-free ring per logging thread, merged into a single timestamp-ordered stream
+ * by the consumer.
+ *
+ * With the shared ring every producer CASes the same enqueue cursor, so the cache line
+ * holding it bounces between cores under contention. Here each thread only ever writes
+ * its own ring; the shared state is touched once per thread, when its ring is created.
+ * A small thread-local cache maps the buffer set to the calling thread's ring.
+ *
+ * DrainMerged k-way merges the drained rings by FGameplayEventRecord::Cycles (or by
+ * Sequence in replay capture), so the stream is globally ordered within each drain. A thread preempted between reading its
+ * timestamp and enqueueing can still land in the following drain.
+ */
+class YOURPROJECT_API FGameplayEventThreadBuffers
+{
+public:
+    explicit FGameplayEventThreadBuffers(uint32 InCapacityPerThread);
+    ~FGameplayEventThreadBuffers();
+
+    FGameplayEventThreadBuffers(const FGameplayEventThreadBuffers&) = delete;
+    FGameplayEventThreadBuffers& operator=(const FGameplayEventThreadBuffers&) = delete;
+
+    /** Pushes into the calling thread's ring, creating it on first use. Returns false, leaving Item untouched, if it is full. */
+    bool TryEnqueue(FGameplayEventPendingRecord&& Item);
+
+    /** Drains every ring and passes the items to Sink in timestamp order. Single consumer only. Returns the number drained. */
+    int32 DrainMerged(TFunctionRef<void(FGameplayEventPendingRecord&& Item)> Sink);
+
+    /** Approximate number of queued items across all threads. */
+    int32 GetApproximateNum() const;
+
+    /** Number of threads that have logged through this buffer set. */
+    int32 GetNumThreads() const;
+
+private:
+    struct FThreadBuffer;
+
+    /** Slow path of TryEnqueue: finds or creates the ring of the calling thread and caches it. */
+    FThreadBuffer& FindOrAddThreadBuffer();
+
+    /** Distinguishes buffer sets in the thread-local cache, so a stale entry never matches a new set at the same address. */
+    const uint64 Serial;
+
+    uint32 CapacityPerThread;
+
+    /** Guards Buffers. Producers only take it when registering a new thread. */
+    mutable FCriticalSection BuffersMutex;
+    TArray<TUniquePtr<FThreadBuffer>> Buffers;
+
+    /** Consumer-side scratch reused between drains: drained items, one run per ring, and the merge heap. */
+    TArray<FGameplayEventPendingRecord> MergeScratch;
+    TArray<int32> RunEnds;
+};
@@ -5,6 +5,86 @@
 #include "UObject/UnrealType.h"
 #include "HAL/PlatformMemory.h"
 #include "Misc/OutputDeviceNull.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_STATS_GROUP(TEXT("MemoryUsageTracker"), STATGROUP_MemoryUsageTracker, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Sampling Tick"), STAT_MemoryUsageTracker_Tick, STATGROUP_MemoryUsageTracker);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Pass Latency (ms)"), STAT_MemoryUsageTracker_PassLatency, STATGROUP_MemoryUsageTracker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Pass Frames"), STAT_MemoryUsageTracker_PassFrames, STATGROUP_MemoryUsageTracker);
+DECLARE_CYCLE_STAT(TEXT("Calculate Memory Usage"), STAT_MemoryUsageTracker_Calculate, STATGROUP_MemoryUsageTracker);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Objects Measured"), STAT_MemoryUsageTracker_ObjectsMeasured, STATGROUP_MemoryUsageTracker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Measurement Plans"), STAT_MemoryUsageTracker_Plans, STATGROUP_MemoryUsageTracker);
+DECLARE_CYCLE_STAT(TEXT("Measure Objects"), STAT_MemoryUsageTracker_MeasureRange, STATGROUP_MemoryUsageTracker);
+DECLARE_CYCLE_STAT(TEXT("Reference Walk"), STAT_MemoryUsageTracker_ReferenceWalk, STATGROUP_MemoryUsageTracker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Last Pass Reference Nodes"), STAT_MemoryUsageTracker_ReferenceNodes, STATGROUP_MemoryUsageTracker);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shared Referenced Objects"), STAT_MemoryUsageTracker_SharedReferences, STATGROUP_MemoryUsageTracker);
+DECLARE_CYCLE_STAT(TEXT("Resource Size"), STAT_MemoryUsageTracker_ResourceSize, STATGROUP_MemoryUsageTracker);
+
+namespace MemoryUsageTrackerPrivate
+{
+    /** FMemoryReferenceOwner::InfoIndex of objects reached from more than one tracked object. */
+    constexpr int32 SharedOwner = INDEX_NONE;
+
+    /** Referenced objects visited between two deadline checks of a time-sliced reference walk. */
+    constexpr int32 WalkNodesPerDeadlineCheck = 64;
+
+    /** Allocation-flag bits a sparse array keeps inline before it allocates them. */
+    constexpr int32 InlineAllocationFlags = 128;
+
+    /**
+     * Element slots allocated by the sparse array of a set or map, slack included. FScriptMap starts
+     * with its FScriptSet, which starts with its FScriptSparseArray, which starts with the
+     * FScriptArray of slots, so the capacity is read from there; the helpers only expose the max
+     * index, which stops at the highest slot ever used.
+     */
+    const FScriptArray& GetSparseSlots(const uint8* SetOrMap)
+    {
+        return *reinterpret_cast<const FScriptArray*>(SetOrMap);
+    }
+
+    /**
+     * Heap bytes of a sparse array's allocation flags beyond the inline ones, one bit per slot of
+     * SlotCapacity. The flags grow with the slots, so this matches TSparseArray::GetAllocatedSize
+     * unless the flags were reserved separately.
+     */
+    int64 GetAllocationFlagBytes(int32 SlotCapacity)
+    {
+        return SlotCapacity > InlineAllocationFlags ? FMath::DivideAndRoundUp(SlotCapacity, 32) * static_cast<int64>(sizeof(uint32)) : 0;
+    }
+
+    /**
+     * Heap bytes of the hash of a set holding NumElements; one bucket is inline. A lower bound: the
+     * hash is sized for the most elements the set held or was reserved for and does not shrink on
+     * Remove, but its size is not reachable through reflection.
+     */
+    int64 GetSetHashBytes(int32 NumElements)
+    {
+        const uint32 NumBuckets = FDefaultSetAllocator::GetNumberOfHashBuckets(static_cast<uint32>(NumElements));
+        return NumBuckets > 1 ? static_cast<int64>(NumBuckets) * sizeof(FSetElementId) : 0;
+    }
+
+    /**
+     * Adds the usable size of the heap block at Data to *AllocatorBytes, or EstimatedBytes when
+     * the allocator cannot size it. Does nothing when AllocatorBytes is null.
+     */
+    void TallyBlock(int64* AllocatorBytes, const void* Data, int64 EstimatedBytes)
+    {
+        if (!AllocatorBytes)
+        {
+            return;
+        }
+
+        SIZE_T UsableSize = 0;
+        if (Data && GMalloc->GetAllocationSize(const_cast<void*>(Data), UsableSize))
+        {
+            *AllocatorBytes += static_cast<int64>(UsableSize);
+        }
+        else
+        {
+            *AllocatorBytes += EstimatedBytes;
+        }
+    }
+}
 
 UMemoryUsageTracker::UMemoryUsageTracker()
 {
@@ -16,59 +96,151 @@ void UMemoryUsageTracker::BeginPlay()
 {
     Super::BeginPlay();
     TimeAccumulator = 0.0f;
+
+#if WITH_EDITOR
+    // Reloaded classes can change layout; plans are rebuilt on next use
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddWeakLambda(this, [this](EReloadCompleteReason)
+    {
+        ResetMeasurePlans();
+    });
+
+    // Recompiling a Blueprint or user defined struct can keep the UClass or UScriptStruct while
+    // replacing its properties, which the plans point at
+    ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddWeakLambda(this, [this](const TMap<UObject*, UObject*>&)
+    {
+        ResetMeasurePlans();
+    });
+    ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddWeakLambda(this, [this](const TMap<UObject*, UObject*>&)
+    {
+        ResetMeasurePlans();
+    });
+#endif
 }
 
 void UMemoryUsageTracker::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
     StopTracking();
+
+#if WITH_EDITOR
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+    FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+
+    PassObjects.Empty();
+    PendingMemoryInfo.Empty();
+    ReferenceOwners.Empty();
+    PassRoots.Empty();
+    PassCursor = 0;
+    ReferenceQueue.Empty();
+    ReferenceQueueHead = 0;
+    WalkInfoIndex = INDEX_NONE;
+    NextWalkInfo = 0;
 }
 
 void UMemoryUsageTracker::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    if (SampleInterval <= 0.f || TrackedObjects.Num() == 0)
+    if (SampleInterval <= 0.f || (TrackedObjects.Num() == 0 && !IsPassInProgress()))
     {
         return;
     }
 
+    SCOPE_CYCLE_COUNTER(STAT_MemoryUsageTracker_Tick);
+
     TimeAccumulator += DeltaTime;
-    if (TimeAccumulator >= SampleInterval)
+    if (!IsPassInProgress())
     {
+        if (TimeAccumulator < SampleInterval)
+        {
+            return;
+        }
+
         TimeAccumulator = 0.f;
-        ClearCachedInfo();
+        BeginPass();
+    }
 
-        for (int32 Index = TrackedObjects.Num() - 1; Index >= 0; --Index)
+    ContinuePass(bTimeSliced ? FMath::Max(TimeSliceBudgetMs, 0.01f) / 1000.0 : 0.0);
+}
+
+void UMemoryUsageTracker::BeginPass()
+{
+    PassObjects = TrackedObjects;
+    PassCursor = 0;
+    PassFrames = 0;
+    PassStartSeconds = FPlatformTime::Seconds();
+
+    PendingMemoryInfo.Reset(PassObjects.Num());
+
+    ReferenceOwners.Reset();
+    PassRoots.Reset();
+    PassSharedReferences = 0;
+    PassReferenceNodes = 0;
+    ReferenceQueue.Reset();
+    ReferenceQueueHead = 0;
+    WalkInfoIndex = INDEX_NONE;
+    NextWalkInfo = 0;
+
+    for (const TWeakObjectPtr<UObject>& WeakObj : PassObjects)
+    {
+        if (const UObject* Obj = WeakObj.Get())
         {
-            if (TWeakObjectPtr<UObject> WeakObj = TrackedObjects[Index])
-            {
-                UObject* Obj = WeakObj.Get();
-                if (Obj && !Obj->IsPendingKill())
-                {
-                    FMemoryUsageInfo Info;
-                    Info.TrackedObject = Obj;
-                    Info.ObjectName = Obj->GetName();
-                    Info.MemoryBytes = CalculateMemoryUsage(Obj);
+            PassRoots.Add(FObjectKey(Obj));
+        }
+    }
+}
 
-                    TSet<UObject*> VisitedSet;
-                    Info.NumReferencedObjects = CountReferencedObjects(Obj, VisitedSet);
+void UMemoryUsageTracker::ContinuePass(double BudgetSeconds)
+{
+    const double Deadline = BudgetSeconds > 0.0 ? FPlatformTime::Seconds() + BudgetSeconds : TNumericLimits<double>::Max();
+    ++PassFrames;
 
-                    CachedMemoryInfo.Add(Info);
-                }
-                else
-                {
-                    // Remove invalid references
-                    TrackedObjects.RemoveAtSwap(Index);
-                }
-            }
-            else
-            {
-                // Remove null weak pointer
-                TrackedObjects.RemoveAtSwap(Index);
-            }
+    // A walk resumed from the last frame counts as this frame's progress; it always visits some nodes
+    bool bMadeProgress = WalkInfoIndex != INDEX_NONE || NextWalkInfo < PendingMemoryInfo.Num();
+
+    // The references of measured objects are walked before more objects are measured
+    while (WalkPendingReferences(Deadline) && PassCursor < PassObjects.Num())
+    {
+        const double RoundStart = FPlatformTime::Seconds();
+        if (bMadeProgress && RoundStart >= Deadline)
+        {
+            break;
         }
+
+        const int32 RoundEnd = FMath::Min(PassCursor + GetMeasureRoundSize(BudgetSeconds > 0.0 ? Deadline - RoundStart : 0.0), PassObjects.Num());
+        MeasurePassRange(PassCursor, RoundEnd);
+
+        const double SecondsPerObject = (FPlatformTime::Seconds() - RoundStart) / (RoundEnd - PassCursor);
+        SecondsPerMeasuredObject = SecondsPerMeasuredObject > 0.0 ? 0.5 * (SecondsPerMeasuredObject + SecondsPerObject) : SecondsPerObject;
+
+        PassCursor = RoundEnd;
+        bMadeProgress = true;
     }
+
+    if (IsPassInProgress())
+    {
+        return;
+    }
+
+    // Only complete passes are published, so readers never see a half-measured set
+    CachedMemoryInfo = MoveTemp(PendingMemoryInfo);
+    PendingMemoryInfo.Reset();
+    PassObjects.Reset();
+    PassCursor = 0;
+
+    SharedReferencedObjects = PassSharedReferences;
+    SET_DWORD_STAT(STAT_MemoryUsageTracker_SharedReferences, SharedReferencedObjects);
+    SET_DWORD_STAT(STAT_MemoryUsageTracker_ReferenceNodes, PassReferenceNodes);
+    ReferenceOwners.Reset();
+    PassRoots.Reset();
+    NextWalkInfo = 0;
+
+    LastPassLatencyMs = static_cast<float>((FPlatformTime::Seconds() - PassStartSeconds) * 1000.0);
+    SET_FLOAT_STAT(STAT_MemoryUsageTracker_PassLatency, LastPassLatencyMs);
+    LastPassFrames = PassFrames;
+    SET_DWORD_STAT(STAT_MemoryUsageTracker_PassFrames, LastPassFrames);
 }
 
 void UMemoryUsageTracker::StartTracking(float SamplingInterval)
@@ -131,117 +303,590 @@ void UMemoryUsageTracker::DumpMemoryUsageToLog() const
 
     for (const FMemoryUsageInfo& Info : CachedMemoryInfo)
     {
-        UE_LOG(LogTemp, Log, TEXT("Object: %s | Memory: %.2f KB | References: %d"),
-            *Info.ObjectName, Info.MemoryBytes / 1024.0f, Info.NumReferencedObjects);
+        UE_LOG(LogTemp, Log, TEXT("Object: %s | Memory: %.2f KB | Allocator: %.2f KB | Resource: %.2f KB exclusive, %.2f KB inclusive | References: %d"),
+            *Info.ObjectName, Info.MemoryBytes / 1024.0f, Info.AllocatorBytes / 1024.0f, Info.ResourceExclusiveBytes / 1024.0f,
+            Info.ResourceInclusiveBytes / 1024.0f, Info.NumReferencedObjects);
     }
 
+    UE_LOG(LogTemp, Log, TEXT("Shared referenced objects: %d"), SharedReferencedObjects);
+    UE_LOG(LogTemp, Log, TEXT("Last pass: %.3f ms over %d frame(s)"), LastPassLatencyMs, LastPassFrames);
     UE_LOG(LogTemp, Log, TEXT("---- Memory Usage Tracker Dump End ----"));
 }
 
-int64 UMemoryUsageTracker::CalculateMemoryUsage(UObject* Object) const
+void UMemoryUsageTracker::MeasurePassRange(int32 First, int32 Last)
 {
-    if (!Object)
+    // Weak pointers are resolved and stale entries dropped on the game thread
+    TArray<UObject*> Objects;
+    Objects.Reserve(Last - First);
+
+    for (int32 Index = First; Index < Last; ++Index)
     {
-        return 0;
+        const TWeakObjectPtr<UObject>& WeakObj = PassObjects[Index];
+
+        UObject* Obj = WeakObj.Get();
+        if (Obj && !Obj->IsPendingKill())
+        {
+            Objects.Add(Obj);
+        }
+        else
+        {
+            // Remove invalid or null references
+            TrackedObjects.RemoveSingleSwap(WeakObj);
+        }
     }
 
-    // Rough estimation: sum of all UProperties memory + UObject overhead + referenced subobjects size
+    if (Objects.Num() == 0)
+    {
+        return;
+    }
 
-    int64 TotalSize = 0;
+    SCOPE_CYCLE_COUNTER(STAT_MemoryUsageTracker_MeasureRange);
+
+    // The plan cache is not thread-safe: build every missing plan first, then only read it
+    for (const UObject* Obj : Objects)
+    {
+        GetMeasurePlan(Obj->GetClass());
+    }
+
+    TArray<const FMemoryMeasurePlan*> Plans;
+    Plans.Reserve(Objects.Num());
+    for (const UObject* Obj : Objects)
+    {
+        Plans.Add(MeasurePlans.Find(Obj->GetClass()));
+    }
+
+    const int32 FirstInfo = PendingMemoryInfo.AddDefaulted(Objects.Num());
+
+    // Garbage collection runs on the game thread, which waits inside ParallelFor until every
+    // batch is done, so no object can be collected while the workers read it
+    const int32 BatchSize = FMath::Max(ParallelBatchSize, 1);
+    const int32 NumBatches = FMath::DivideAndRoundUp(Objects.Num(), BatchSize);
+
+    ParallelFor(NumBatches, [this, &Objects, &Plans, FirstInfo, BatchSize](int32 BatchIndex)
+    {
+        const int32 BatchEnd = FMath::Min((BatchIndex + 1) * BatchSize, Objects.Num());
+        for (int32 Index = BatchIndex * BatchSize; Index < BatchEnd; ++Index)
+        {
+            UObject* Obj = Objects[Index];
+
+            // Each index owns its slot, so workers never write the same element
+            FMemoryUsageInfo& Info = PendingMemoryInfo[FirstInfo + Index];
+            Info.TrackedObject = Obj;
+            Info.ObjectName = Obj->GetName();
+            CalculateMemoryUsage(Obj, *Plans[Index], Info);
+        }
+    }, !bParallelMeasure);
+
+    // Resource sizes can touch render resources and asset state, so they are not read from workers
+    if (bIncludeResourceSizes)
+    {
+        for (int32 Index = 0; Index < Objects.Num(); ++Index)
+        {
+            CalculateResourceSizes(Objects[Index], PendingMemoryInfo[FirstInfo + Index]);
+        }
+    }
+}
+
+void UMemoryUsageTracker::ResetMeasurePlans()
+{
+    DEC_DWORD_STAT_BY(STAT_MemoryUsageTracker_Plans, MeasurePlans.Num());
+    MeasurePlans.Empty();
+}
+
+int32 UMemoryUsageTracker::GetMeasureRoundSize(double RemainingSeconds) const
+{
+    if (RemainingSeconds <= 0.0)
+    {
+        // No budget: the whole pass is one round
+        return PassObjects.Num();
+    }
 
-    // UObject base size (platform dependent, approximate)
-    TotalSize += sizeof(*Object);
+    if (!bParallelMeasure)
+    {
+        return 1;
+    }
 
-    // Calculate size of properties
-    for (TFieldIterator<FProperty> PropIt(Object->GetClass()); PropIt; ++PropIt)
+    if (SecondsPerMeasuredObject <= 0.0)
+    {
+        // Nothing measured yet: one batch tells what an object costs
+        return FMath::Max(ParallelBatchSize, 1);
+    }
+
+    return FMath::Max(static_cast<int32>(FMath::Min(RemainingSeconds / SecondsPerMeasuredObject, static_cast<double>(PassObjects.Num()))), 1);
+}
+
+const FMemoryMeasurePlan& UMemoryUsageTracker::GetMeasurePlan(const UStruct* Struct) const
+{
+    if (const FMemoryMeasurePlan* Plan = MeasurePlans.Find(Struct))
+    {
+        if (IsPlanCurrent(*Plan, Struct))
+        {
+            return *Plan;
+        }
+
+        // Only this entry goes: a parent plan may be mid-build, holding its placeholder. Plans of
+        // the structs it contains are checked again as it is rebuilt
+        MeasurePlans.Remove(Struct);
+    }
+    else
+    {
+        INC_DWORD_STAT(STAT_MemoryUsageTracker_Plans);
+    }
+
+    // Placeholder first, so a struct holding an array of itself does not build forever
+    MeasurePlans.Add(Struct);
+    FMemoryMeasurePlan Plan = BuildMeasurePlan(Struct);
+
+    FMemoryMeasurePlan& Stored = MeasurePlans.FindChecked(Struct);
+    Stored = MoveTemp(Plan);
+    return Stored;
+}
+
+bool UMemoryUsageTracker::IsPlanCurrent(const FMemoryMeasurePlan& Plan, const UStruct* Struct)
+{
+    // A placeholder still being built has no properties recorded yet
+    if (Plan.FixedBytes != Struct->GetPropertiesSize() || Plan.PropertyLink != Struct->PropertyLink)
+    {
+        return Plan.FixedBytes == 0 && Plan.PropertyLink == nullptr;
+    }
+
+    int32 NumProperties = 0;
+    for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+    {
+        ++NumProperties;
+    }
+    return NumProperties == Plan.NumProperties;
+}
+
+FMemoryMeasurePlan UMemoryUsageTracker::BuildMeasurePlan(const UStruct* Struct) const
+{
+    FMemoryMeasurePlan Plan;
+
+    // The allocation holding the instance: native base, every property and padding
+    Plan.FixedBytes = Struct->GetPropertiesSize();
+
+    Plan.PropertyLink = Struct->PropertyLink;
+    for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+    {
+        ++Plan.NumProperties;
+    }
+
+    for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
     {
         FProperty* Property = *PropIt;
 
         if (!Property)
             continue;
 
-        void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
-
-        // Handle array properties separately
-        if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+        const EMemoryMeasureKind Kind = ClassifyProperty(Property);
+        if (Kind != EMemoryMeasureKind::None)
         {
-            FScriptArrayHelper Helper(ArrayProp, ValuePtr);
-            int32 ElementSize = ArrayProp->Inner->ElementSize;
+            FMemoryMeasureStep& Step = Plan.Steps.AddDefaulted_GetRef();
+            Step.Offset = Property->GetOffset_ForInternal();
+            Step.ArrayDim = Property->ArrayDim;
+            Step.Stride = Property->ElementSize;
+            Step.Kind = Kind;
+            Step.Property = Property;
+
+            if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+            {
+                Step.ElementKind = ClassifyProperty(ArrayProp->Inner);
+            }
+            else if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
+            {
+                Step.ElementKind = ClassifyProperty(SetProp->ElementProp);
+            }
+            else if (const FMapProperty* MapProp = CastField<FMapProperty>(Property))
+            {
+                Step.ElementKind = ClassifyProperty(MapProp->KeyProp);
+                Step.ValueKind = ClassifyProperty(MapProp->ValueProp);
+            }
+        }
 
-            TotalSize += Helper.Num() * ElementSize;
+        // Object references: don't add size here to avoid double counting, followed by the reference walk
+        if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(Property))
+        {
+            FMemoryReferenceStep& Step = Plan.ReferenceSteps.AddDefaulted_GetRef();
+            Step.Offset = ObjProp->GetOffset_ForInternal();
+            Step.ObjectProperty = ObjProp;
         }
-        else if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
+        else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
         {
-            FString* StrPtr = reinterpret_cast<FString*>(ValuePtr);
-            if (StrPtr)
+            if (FObjectPropertyBase* InnerObjProp = CastField<FObjectPropertyBase>(ArrayProp->Inner))
             {
-                TotalSize += StrPtr->GetAllocatedSize();
+                FMemoryReferenceStep& Step = Plan.ReferenceSteps.AddDefaulted_GetRef();
+                Step.Offset = ArrayProp->GetOffset_ForInternal();
+                Step.ObjectProperty = InnerObjProp;
+                Step.bArray = true;
             }
         }
-        else if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+    }
+
+    return Plan;
+}
+
+EMemoryMeasureKind UMemoryUsageTracker::ClassifyProperty(const FProperty* Property) const
+{
+    if (CastField<FStrProperty>(Property))
+    {
+        return EMemoryMeasureKind::String;
+    }
+    if (CastField<FArrayProperty>(Property))
+    {
+        return EMemoryMeasureKind::Array;
+    }
+    if (CastField<FSetProperty>(Property))
+    {
+        return EMemoryMeasureKind::Set;
+    }
+    if (CastField<FMapProperty>(Property))
+    {
+        return EMemoryMeasureKind::Map;
+    }
+    if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+    {
+        // Structs of plain values live entirely inline and need no step
+        return GetMeasurePlan(StructProp->Struct).Steps.Num() > 0 ? EMemoryMeasureKind::Struct : EMemoryMeasureKind::None;
+    }
+
+    // Plain values are inline; FName memory handled internally; objects are measured on their own
+    return EMemoryMeasureKind::None;
+}
+
+void UMemoryUsageTracker::CalculateMemoryUsage(const UObject* Object, const FMemoryMeasurePlan& Plan, FMemoryUsageInfo& OutInfo) const
+{
+    using namespace MemoryUsageTrackerPrivate;
+
+    SCOPE_CYCLE_COUNTER(STAT_MemoryUsageTracker_Calculate);
+    INC_DWORD_STAT(STAT_MemoryUsageTracker_ObjectsMeasured);
+
+    int64 AllocatorBytes = 0;
+    int64* AllocatorTally = bQueryAllocatorSizes ? &AllocatorBytes : nullptr;
+
+    TallyBlock(AllocatorTally, Object, Plan.FixedBytes);
+    OutInfo.MemoryBytes = Plan.FixedBytes + MeasureHeap(Plan, reinterpret_cast<const uint8*>(Object), AllocatorTally);
+    OutInfo.AllocatorBytes = AllocatorBytes;
+}
+
+void UMemoryUsageTracker::CalculateResourceSizes(UObject* Object, FMemoryUsageInfo& OutInfo)
+{
+    SCOPE_CYCLE_COUNTER(STAT_MemoryUsageTracker_ResourceSize);
+
+    FResourceSizeEx Exclusive(EResourceSizeMode::Exclusive);
+    Object->GetResourceSizeEx(Exclusive);
+    OutInfo.ResourceExclusiveBytes = static_cast<int64>(Exclusive.GetTotalMemoryBytes());
+
+    FResourceSizeEx Inclusive(EResourceSizeMode::EstimatedTotal);
+    Object->GetResourceSizeEx(Inclusive);
+    OutInfo.ResourceInclusiveBytes = static_cast<int64>(Inclusive.GetTotalMemoryBytes());
+}
+
+int64 UMemoryUsageTracker::MeasureHeap(const FMemoryMeasurePlan& Plan, const uint8* Container, int64* AllocatorBytes) const
+{
+    int64 TotalSize = 0;
+
+    for (const FMemoryMeasureStep& Step : Plan.Steps)
+    {
+        const uint8* ValuePtr = Container + Step.Offset;
+        for (int32 Index = 0; Index < Step.ArrayDim; ++Index)
         {
-            // FName memory handled internally, ignore
+            TotalSize += MeasureStep(Step, ValuePtr + Index * Step.Stride, AllocatorBytes);
         }
-        else if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(Property))
+    }
+
+    return TotalSize;
+}
+
+int64 UMemoryUsageTracker::MeasureStep(const FMemoryMeasureStep& Step, const uint8* Value, int64* AllocatorBytes) const
+{
+    using namespace MemoryUsageTrackerPrivate;
+
+    switch (Step.Kind)
+    {
+    case EMemoryMeasureKind::String:
+        return MeasureElement(EMemoryMeasureKind::String, nullptr, Value, AllocatorBytes);
+
+    case EMemoryMeasureKind::Struct:
+        return MeasureHeap(MeasurePlans.FindChecked(CastFieldChecked<FStructProperty>(Step.Property)->Struct), Value, AllocatorBytes);
+
+    case EMemoryMeasureKind::Array:
+    {
+        const FArrayProperty* ArrayProp = CastFieldChecked<FArrayProperty>(Step.Property);
+        const FScriptArray& Array = *reinterpret_cast<const FScriptArray*>(Value);
+        const int32 ElementSize = ArrayProp->Inner->ElementSize;
+
+        // Slack included: the allocator holds Max elements, not Num
+        int64 TotalSize = static_cast<int64>(Array.Max()) * ElementSize;
+        TallyBlock(AllocatorBytes, Array.GetData(), TotalSize);
+
+        if (Step.ElementKind != EMemoryMeasureKind::None)
         {
-            // Object references: don't add size here to avoid double counting, handled recursively
+            const FMemoryMeasurePlan* ElementPlan = FindElementPlan(Step.ElementKind, ArrayProp->Inner);
+            const uint8* Elements = static_cast<const uint8*>(Array.GetData());
+            for (int32 Index = 0; Index < Array.Num(); ++Index)
+            {
+                TotalSize += MeasureElement(Step.ElementKind, ElementPlan, Elements + Index * ElementSize, AllocatorBytes);
+            }
         }
-        else
+        return TotalSize;
+    }
+
+    case EMemoryMeasureKind::Set:
+    {
+        const FSetProperty* SetProp = CastFieldChecked<FSetProperty>(Step.Property);
+        FScriptSetHelper Helper(SetProp, Value);
+
+        const int32 MaxIndex = Helper.GetMaxIndex();
+        const FScriptArray& Slots = GetSparseSlots(Value);
+        const int64 ElementBytes = static_cast<int64>(Slots.Max()) * Helper.SetLayout.Size;
+        const int64 OverheadBytes = GetAllocationFlagBytes(Slots.Max()) + GetSetHashBytes(Helper.Num());
+
+        // Flag and hash blocks are not reachable through reflection and stay estimated
+        TallyBlock(AllocatorBytes, Slots.GetData(), ElementBytes);
+        TallyBlock(AllocatorBytes, nullptr, OverheadBytes);
+
+        int64 TotalSize = ElementBytes + OverheadBytes;
+
+        if (Step.ElementKind != EMemoryMeasureKind::None)
         {
-            // For simple POD types
-            TotalSize += Property->ElementSize;
+            const FMemoryMeasurePlan* ElementPlan = FindElementPlan(Step.ElementKind, SetProp->ElementProp);
+            for (int32 Index = 0; Index < MaxIndex; ++Index)
+            {
+                if (Helper.IsValidIndex(Index))
+                {
+                    TotalSize += MeasureElement(Step.ElementKind, ElementPlan, Helper.GetElementPtr(Index), AllocatorBytes);
+                }
+            }
         }
+        return TotalSize;
     }
 
-    return TotalSize;
+    case EMemoryMeasureKind::Map:
+    {
+        const FMapProperty* MapProp = CastFieldChecked<FMapProperty>(Step.Property);
+        FScriptMapHelper Helper(MapProp, Value);
+
+        const int32 MaxIndex = Helper.GetMaxIndex();
+        const FScriptArray& Slots = GetSparseSlots(Value);
+        const int64 ElementBytes = static_cast<int64>(Slots.Max()) * Helper.MapLayout.SetLayout.Size;
+        const int64 OverheadBytes = GetAllocationFlagBytes(Slots.Max()) + GetSetHashBytes(Helper.Num());
+
+        TallyBlock(AllocatorBytes, Slots.GetData(), ElementBytes);
+        TallyBlock(AllocatorBytes, nullptr, OverheadBytes);
+
+        int64 TotalSize = ElementBytes + OverheadBytes;
+
+        if (Step.ElementKind != EMemoryMeasureKind::None || Step.ValueKind != EMemoryMeasureKind::None)
+        {
+            const FMemoryMeasurePlan* KeyPlan = FindElementPlan(Step.ElementKind, MapProp->KeyProp);
+            const FMemoryMeasurePlan* ValuePlan = FindElementPlan(Step.ValueKind, MapProp->ValueProp);
+            for (int32 Index = 0; Index < MaxIndex; ++Index)
+            {
+                if (Helper.IsValidIndex(Index))
+                {
+                    TotalSize += MeasureElement(Step.ElementKind, KeyPlan, Helper.GetKeyPtr(Index), AllocatorBytes);
+                    TotalSize += MeasureElement(Step.ValueKind, ValuePlan, Helper.GetValuePtr(Index), AllocatorBytes);
+                }
+            }
+        }
+        return TotalSize;
+    }
+
+    default:
+        return 0;
+    }
 }
 
-int32 UMemoryUsageTracker::CountReferencedObjects(UObject* Object, TSet<UObject*>& Visited) const
+int64 UMemoryUsageTracker::MeasureElement(EMemoryMeasureKind Kind, const FMemoryMeasurePlan* StructPlan, const uint8* Value, int64* AllocatorBytes) const
 {
-    if (!Object || Visited.Contains(Object))
+    using namespace MemoryUsageTrackerPrivate;
+
+    switch (Kind)
+    {
+    case EMemoryMeasureKind::String:
     {
+        const FString& String = *reinterpret_cast<const FString*>(Value);
+        const int64 AllocatedSize = String.GetAllocatedSize();
+        TallyBlock(AllocatorBytes, String.GetCharArray().GetData(), AllocatedSize);
+        return AllocatedSize;
+    }
+
+    case EMemoryMeasureKind::Struct:
+        return MeasureHeap(*StructPlan, Value, AllocatorBytes);
+
+    default:
         return 0;
     }
+}
 
-    Visited.Add(Object);
+const FMemoryMeasurePlan* UMemoryUsageTracker::FindElementPlan(EMemoryMeasureKind Kind, const FProperty* ElementProperty) const
+{
+    return Kind == EMemoryMeasureKind::Struct ? MeasurePlans.Find(CastFieldChecked<FStructProperty>(ElementProperty)->Struct) : nullptr;
+}
 
-    int32 Count = 1; // count self
+bool UMemoryUsageTracker::WalkPendingReferences(double Deadline)
+{
+    using namespace MemoryUsageTrackerPrivate;
 
-    for (TFieldIterator<FProperty> PropIt(Object->GetClass()); PropIt; ++PropIt)
+    SCOPE_CYCLE_COUNTER(STAT_MemoryUsageTracker_ReferenceWalk);
+
+    int32 NodeBudget = WalkNodesPerDeadlineCheck;
+    while (true)
     {
-        FProperty* Property = *PropIt;
-        if (!Property)
+        if (WalkInfoIndex == INDEX_NONE)
+        {
+            // Attribution depends on which tracked object reaches a node first, so roots are walked in measuring order
+            if (NextWalkInfo >= PendingMemoryInfo.Num())
+            {
+                return true;
+            }
+
+            // Null if the object was destroyed and collected since it was measured
+            if (UObject* Root = PendingMemoryInfo[NextWalkInfo].TrackedObject)
+            {
+                BeginReferenceWalk(Root, NextWalkInfo);
+            }
+            ++NextWalkInfo;
+            --NodeBudget;
             continue;
+        }
 
-        void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Object);
+        if (ContinueReferenceWalk(NodeBudget) && NodeBudget > 0)
+        {
+            continue;
+        }
 
-        if (FObjectPropertyBase* ObjProp = CastField<FObjectPropertyBase>(Property))
+        // Checked after each slice of nodes so every frame makes progress, however small the budget
+        if (FPlatformTime::Seconds() >= Deadline)
         {
-            UObject* RefObject = ObjProp->GetObjectPropertyValue(ValuePtr);
-            if (RefObject && !Visited.Contains(RefObject))
+            return false;
+        }
+        NodeBudget = WalkNodesPerDeadlineCheck;
+    }
+}
+
+void UMemoryUsageTracker::BeginReferenceWalk(UObject* Root, int32 InfoIndex)
+{
+    WalkInfoIndex = InfoIndex;
+    ReferenceQueue.Reset();
+    ReferenceQueueHead = 0;
+
+    // A tracked object always counts itself, whoever else reached it
+    ReferenceOwners.Add(FObjectKey(Root), FMemoryReferenceOwner{ InfoIndex, 0 });
+    PendingMemoryInfo[InfoIndex].NumReferencedObjects = 1;
+
+    if (MaxReferenceDepth > 0)
+    {
+        PushReferences(Root, 1);
+    }
+}
+
+void UMemoryUsageTracker::PushReferences(UObject* Object, int32 Depth)
+{
+    const uint8* ObjectBytes = reinterpret_cast<const uint8*>(Object);
+
+    for (const FMemoryReferenceStep& Step : GetMeasurePlan(Object->GetClass()).ReferenceSteps)
+    {
+        const uint8* ValuePtr = ObjectBytes + Step.Offset;
+
+        if (!Step.bArray)
+        {
+            if (UObject* RefObject = Step.ObjectProperty->GetObjectPropertyValue(ValuePtr))
             {
-                Count += CountReferencedObjects(RefObject, Visited);
+                ReferenceQueue.Emplace(FObjectKey(RefObject), Depth);
             }
+            continue;
         }
-        else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+
+        const FScriptArray& Array = *reinterpret_cast<const FScriptArray*>(ValuePtr);
+        const uint8* Elements = static_cast<const uint8*>(Array.GetData());
+        for (int32 Index = 0; Index < Array.Num(); ++Index)
         {
-            FScriptArrayHelper Helper(ArrayProp, ValuePtr);
-            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            if (UObject* RefObject = Step.ObjectProperty->GetObjectPropertyValue(Elements + Index * Step.ObjectProperty->ElementSize))
             {
-                void* ElementPtr = Helper.GetRawPtr(Index);
-                if (FObjectPropertyBase* InnerObjProp = CastField<FObjectPropertyBase>(ArrayProp->Inner))
-                {
-                    UObject* RefObject = InnerObjProp->GetObjectPropertyValue(ElementPtr);
-                    if (RefObject && !Visited.Contains(RefObject))
-                    {
-                        Count += CountReferencedObjects(RefObject, Visited);
-                    }
-                }
+                ReferenceQueue.Emplace(FObjectKey(RefObject), Depth);
+            }
+        }
+    }
+}
+
+bool UMemoryUsageTracker::ContinueReferenceWalk(int32& NodeBudget)
+{
+    using namespace MemoryUsageTrackerPrivate;
+
+    const int32 InfoIndex = WalkInfoIndex;
+
+    // Breadth-first, so every object is first reached from this tracked object by its shortest
+    // path and followed as deep as MaxReferenceDepth allows
+    for (; ReferenceQueueHead < ReferenceQueue.Num(); ++ReferenceQueueHead)
+    {
+        if (NodeBudget <= 0)
+        {
+            return false;
+        }
+
+        if (MaxReferenceNodesPerPass > 0 && PassReferenceNodes >= MaxReferenceNodesPerPass)
+        {
+            // Budget spent: the remaining tracked objects only count themselves this pass
+            break;
+        }
+
+        const FObjectKey Key = ReferenceQueue[ReferenceQueueHead].Key;
+        const int32 Depth = ReferenceQueue[ReferenceQueueHead].Value;
+        --NodeBudget;
+
+        if (PassRoots.Contains(Key))
+        {
+            // Another tracked object: its subgraph is attributed to it
+            continue;
+        }
+
+        FMemoryReferenceOwner* Owner = ReferenceOwners.Find(Key);
+        if (!Owner)
+        {
+            ReferenceOwners.Add(Key, FMemoryReferenceOwner{ InfoIndex, Depth });
+            ++PendingMemoryInfo[InfoIndex].NumReferencedObjects;
+        }
+        else if (Owner->InfoIndex == InfoIndex)
+        {
+            // Already reached from here by a path no longer than this one
+            continue;
+        }
+        else if (Owner->InfoIndex == SharedOwner)
+        {
+            if (Depth >= Owner->Depth)
+            {
+                // Already shared together with everything this path could reach below it
+                continue;
+            }
+
+            // Shared, but reached closer to a tracked object than before: follow it deeper
+            Owner->Depth = Depth;
+        }
+        else
+        {
+            // Reached first from another tracked object: move it, and below it, to the shared bucket
+            --PendingMemoryInfo[Owner->InfoIndex].NumReferencedObjects;
+            Owner->InfoIndex = SharedOwner;
+            Owner->Depth = Depth;
+            ++PassSharedReferences;
+        }
+
+        ++PassReferenceNodes;
+        if (Depth < MaxReferenceDepth)
+        {
+            // Null once collected by a garbage collection between two frames of the walk
+            if (UObject* Object = Key.ResolveObjectPtr())
+            {
+                PushReferences(Object, Depth + 1);
             }
         }
     }
 
-    return Count;
+    ReferenceQueue.Reset();
+    ReferenceQueueHead = 0;
+    WalkInfoIndex = INDEX_NONE;
+    return true;
 }
 
 void UMemoryUsageTracker::ClearCachedInfo()
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
 #include "MemoryUsageTracker.generated.h"
 
 /**
@@ -26,9 +27,122 @@ struct FMemoryUsageInfo
     UPROPERTY(BlueprintReadOnly, Category = "Memory")
     int64 MemoryBytes = 0;
 
-    /** Number of referenced sub-objects (for nested memory tracking). */
+    /**
+     * Number of objects reachable only from this tracked object, itself included. Objects reached
+     * from several tracked objects are counted once, in the tracker's shared bucket.
+     */
     UPROPERTY(BlueprintReadOnly, Category = "Memory")
     int32 NumReferencedObjects = 0;
+
+    /** Engine-reported resource size of the object alone (GetResourceSizeEx, Exclusive). 0 unless bIncludeResourceSizes. */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 ResourceExclusiveBytes = 0;
+
+    /** Engine-reported resource size including the resources the object owns (GetResourceSizeEx, EstimatedTotal). 0 unless bIncludeResourceSizes. */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 ResourceInclusiveBytes = 0;
+
+    /**
+     * MemoryBytes as the platform allocator sees it: the usable size of the object and of every
+     * heap block MemoryBytes counts, bucket rounding included. Blocks the allocator cannot size
+     * fall back to their estimate. 0 unless bQueryAllocatorSizes.
+     */
+    UPROPERTY(BlueprintReadOnly, Category = "Memory")
+    int64 AllocatorBytes = 0;
+};
+
+/** What a measurement step reads at its offset. Sizes follow GetAllocatedSize: capacity, not count. */
+enum class EMemoryMeasureKind : uint8
+{
+    /** Owns no heap memory. */
+    None,
+
+    /** FString: allocated size. */
+    String,
+
+    /** TArray: capacity, plus what each element owns. */
+    Array,
+
+    /** TSet: sparse element storage (capacity) and hash buckets (a lower bound), plus what each element owns. */
+    Set,
+
+    /** TMap: as TSet, over key/value pairs. */
+    Map,
+
+    /** Nested USTRUCT with heap-owning members: its own plan, applied in place. */
+    Struct
+};
+
+/** One property that owns heap memory. */
+struct FMemoryMeasureStep
+{
+    /** Byte offset of the value within the object or struct. */
+    int32 Offset = 0;
+
+    /** Elements of a C-style array property, Stride bytes apart. */
+    int32 ArrayDim = 1;
+    int32 Stride = 0;
+
+    EMemoryMeasureKind Kind = EMemoryMeasureKind::None;
+
+    /**
+     * Kind of array and set elements and map keys; ValueKind of map values. Containers cannot
+     * contain containers directly, so these are None, String or Struct.
+     */
+    EMemoryMeasureKind ElementKind = EMemoryMeasureKind::None;
+    EMemoryMeasureKind ValueKind = EMemoryMeasureKind::None;
+
+    /** The property itself, for the container helpers and struct types. */
+    const FProperty* Property = nullptr;
+};
+
+/** One object reference (or array of them) followed by the reference walk. */
+struct FMemoryReferenceStep
+{
+    /** Byte offset of the reference or array within the object. */
+    int32 Offset = 0;
+
+    /** Reads one reference; handles hard, weak, soft and lazy pointers alike. */
+    const FObjectPropertyBase* ObjectProperty = nullptr;
+
+    /** The value at Offset is a TArray of ObjectProperty elements. */
+    bool bArray = false;
+};
+
+/** Where the reference walk attributed an object it reached. */
+struct FMemoryReferenceOwner
+{
+    /** Index into the pass's memory info, or INDEX_NONE for the shared bucket. */
+    int32 InfoIndex = INDEX_NONE;
+
+    /** Depth the object's references were followed from; a shared object reached shallower is followed again. */
+    int32 Depth = 0;
+};
+
+/**
+ * FMemoryMeasurePlan
+ * ------------------
+ * Precomputed measurement of one UClass or USTRUCT. Everything stored inline is covered by
+ * FixedBytes, the size of the allocation itself; only properties that own heap memory become
+ * steps. Object references are kept apart for the reference walk.
+ *
+ * Steps hold raw FProperty pointers, so the plan also records the layout it was built from and
+ * is rebuilt when the struct no longer matches it.
+ */
+struct FMemoryMeasurePlan
+{
+    /** Size of an instance, padding and native members included. Unused for nested structs, which live inline. */
+    int64 FixedBytes = 0;
+
+    /** Head of the struct's property chain when the plan was built. Relinking or recompiling the struct replaces it. */
+    const FProperty* PropertyLink = nullptr;
+
+    /** Properties in the chain when the plan was built. */
+    int32 NumProperties = 0;
+
+    TArray<FMemoryMeasureStep> Steps;
+
+    TArray<FMemoryReferenceStep> ReferenceSteps;
 };
 
 /**
@@ -37,6 +151,10 @@ struct FMemoryUsageInfo
  * Component to monitor and report memory usage of target actors or components.
  * Supports periodic sampling, detailed tracking, and Blueprint integration.
  *
+ * A sampling pass measures every tracked object. With bTimeSliced the pass is spread over as
+ * many frames as the per-frame budget requires, and GetTrackedMemoryInfo keeps returning the
+ * previous complete pass until the current one finishes.
+ *
  * Typical usage:
  * - Attach to an Actor (e.g., GameMode, Manager).
  * - Register target actors or components to track.
@@ -74,6 +192,14 @@ public:
     UFUNCTION(BlueprintCallable, Category="Memory Tracker")
     void DumpMemoryUsageToLog() const;
 
+    /** Real time in milliseconds between the start and the publication of the last complete pass. */
+    UFUNCTION(BlueprintCallable, Category="Memory Tracker")
+    float GetLastPassLatencyMs() const { return LastPassLatencyMs; }
+
+    /** Objects the last complete pass reached from more than one tracked object. */
+    UFUNCTION(BlueprintCallable, Category="Memory Tracker")
+    int32 GetSharedReferencedObjectCount() const { return SharedReferencedObjects; }
+
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -81,6 +207,18 @@ protected:
     virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 private:
+    /** Checks MeasureHeap against the containers' own accounting and the allocator. */
+    friend class FMemoryUsageTrackerContainerTest;
+
+    /** Runs passes over a synthetic object graph and checks the reference attribution. */
+    friend class FMemoryUsageTrackerReferenceWalkTest;
+
+    /** Times CalculateMemoryUsage with plans against a plain reflection walk. */
+    friend class FMemoryUsageTrackerPlanBenchmark;
+
+    /** Times MeasurePassRange with and without ParallelFor. */
+    friend class FMemoryUsageTrackerParallelBenchmark;
+
     /** Internal timer accumulator for sampling interval. */
     float TimeAccumulator = 0.0f;
 
@@ -88,6 +226,47 @@ private:
     UPROPERTY(EditAnywhere, Category="Memory Tracker")
     float SampleInterval = 5.0f;
 
+    /** Spreads each sampling pass over several frames instead of measuring every object at once. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker")
+    bool bTimeSliced = false;
+
+    /**
+     * Milliseconds of measuring and reference walking per frame while a time-sliced pass runs.
+     * Every frame makes some progress, so a frame can overrun by one object, one parallel round
+     * or a few dozen referenced objects.
+     */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker", meta=(EditCondition="bTimeSliced", ClampMin="0.01"))
+    float TimeSliceBudgetMs = 0.2f;
+
+    /**
+     * Measures objects on task graph workers with ParallelFor. Measuring only reads properties,
+     * and the game thread (and with it garbage collection) waits for the workers. References are
+     * still counted on the game thread. Time-sliced passes size each round from the remaining
+     * budget and the measured cost per object.
+     */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker")
+    bool bParallelMeasure = false;
+
+    /** Objects measured by one worker task. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker", meta=(EditCondition="bParallelMeasure", ClampMin="1"))
+    int32 ParallelBatchSize = 32;
+
+    /** Also reports GetResourceSizeEx in both modes, so textures, meshes and other render resources are accounted for. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker")
+    bool bIncludeResourceSizes = false;
+
+    /** Also reports AllocatorBytes, asking the platform allocator for the usable size of every block found. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker")
+    bool bQueryAllocatorSizes = false;
+
+    /** Longest chain of references followed from a tracked object. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker", meta=(ClampMin="0"))
+    int32 MaxReferenceDepth = 32;
+
+    /** Referenced objects the walk may visit per pass, across all tracked objects. 0 is unlimited. */
+    UPROPERTY(EditAnywhere, Category="Memory Tracker", meta=(ClampMin="0"))
+    int32 MaxReferenceNodesPerPass = 200000;
+
     /** List of tracked objects (Actors or Components). */
     UPROPERTY()
     TArray<TWeakObjectPtr<UObject>> TrackedObjects;
@@ -96,11 +275,152 @@ private:
     UPROPERTY()
     TArray<FMemoryUsageInfo> CachedMemoryInfo;
 
-    /** Performs actual memory measurement for a given UObject. */
-    int64 CalculateMemoryUsage(UObject* Object) const;
+    /** Objects of the pass in progress, copied from TrackedObjects when it started. Empty between passes. */
+    UPROPERTY()
+    TArray<TWeakObjectPtr<UObject>> PassObjects;
+
+    /** Results of the pass in progress, moved to CachedMemoryInfo when it completes. */
+    UPROPERTY(Transient)
+    TArray<FMemoryUsageInfo> PendingMemoryInfo;
+
+    /** Next index into PassObjects to measure. */
+    int32 PassCursor = 0;
+
+    /** Frames the pass in progress has run for. */
+    int32 PassFrames = 0;
+
+    /** FPlatformTime::Seconds() when the pass in progress started. */
+    double PassStartSeconds = 0.0;
+
+    float LastPassLatencyMs = 0.0f;
+
+    /** Frames the last complete pass was spread over. */
+    int32 LastPassFrames = 0;
+
+    int32 SharedReferencedObjects = 0;
+
+    /**
+     * Which tracked object each object reached in this pass is attributed to. Keyed by FObjectKey
+     * because a time-sliced pass keeps this across frames: garbage collection may run in between,
+     * and a new object allocated at a freed address must not pass for one already counted.
+     */
+    TMap<FObjectKey, FMemoryReferenceOwner> ReferenceOwners;
+
+    /** Tracked objects of this pass; the walk stops at them so each counts its own subgraph. */
+    TSet<FObjectKey> PassRoots;
+
+    /** Objects of this pass attributed to the shared bucket. */
+    int32 PassSharedReferences = 0;
+
+    /** Objects the walk visited this pass, against MaxReferenceNodesPerPass. */
+    int32 PassReferenceNodes = 0;
+
+    /**
+     * FIFO of (object, depth) for the breadth-first walk of one tracked object, kept to reuse its
+     * allocation. Holds keys because a time-sliced walk resumes after garbage collection may have run.
+     */
+    TArray<TPair<FObjectKey, int32>> ReferenceQueue;
+
+    /** Next entry of ReferenceQueue to visit. */
+    int32 ReferenceQueueHead = 0;
+
+    /** PendingMemoryInfo entry whose walk is in progress, INDEX_NONE between walks. */
+    int32 WalkInfoIndex = INDEX_NONE;
+
+    /** Next PendingMemoryInfo entry whose references have not been walked yet. */
+    int32 NextWalkInfo = 0;
+
+    /** Running estimate of a measuring round's wall time per object, used to size parallel rounds. */
+    double SecondsPerMeasuredObject = 0.0;
+
+    /** Snapshots TrackedObjects and starts a new pass. */
+    void BeginPass();
+
+    /** Measures pass objects until BudgetSeconds elapse (0 for no limit), publishing the results once all are done. */
+    void ContinuePass(double BudgetSeconds);
+
+    /** Measures PassObjects[First, Last) into PendingMemoryInfo, in parallel when bParallelMeasure is set. */
+    void MeasurePassRange(int32 First, int32 Last);
+
+    /** Objects to measure in the next round of a pass, given the seconds left this frame (0 for no limit). */
+    int32 GetMeasureRoundSize(double RemainingSeconds) const;
+
+    bool IsPassInProgress() const { return PassCursor < PassObjects.Num() || NextWalkInfo < PendingMemoryInfo.Num() || WalkInfoIndex != INDEX_NONE; }
+
+    /**
+     * Measurement plans by class or struct, built on first use together with the plans of every
+     * struct they contain, so measuring only reads this map. Cleared when classes are reloaded,
+     * reinstanced or replaced; a plan whose struct changed layout anyway is rebuilt on next use.
+     */
+    mutable TMap<TWeakObjectPtr<const UStruct>, FMemoryMeasurePlan> MeasurePlans;
+
+#if WITH_EDITOR
+    FDelegateHandle ReloadCompleteHandle;
+    FDelegateHandle ObjectsReinstancedHandle;
+    FDelegateHandle ObjectsReplacedHandle;
+#endif
+
+    /** Drops every plan. Must not run while a pass measures in parallel. */
+    void ResetMeasurePlans();
+
+    /** Returns the measurement plan of Struct, building it on first use or when its layout changed. */
+    const FMemoryMeasurePlan& GetMeasurePlan(const UStruct* Struct) const;
+
+    /** True while Struct still has the properties Plan was built from. */
+    static bool IsPlanCurrent(const FMemoryMeasurePlan& Plan, const UStruct* Struct);
+
+    /** Walks the properties of Struct once to build its plan. */
+    FMemoryMeasurePlan BuildMeasurePlan(const UStruct* Struct) const;
+
+    /** Returns how a value of Property owns heap memory, building the plans of the structs involved. */
+    EMemoryMeasureKind ClassifyProperty(const FProperty* Property) const;
+
+    /*
+     * The Measure functions return estimated bytes. When AllocatorBytes is not null they also add
+     * the allocator's usable size of every block they count to it.
+     */
+
+    /** Heap bytes owned by the members of a class or struct instance at Container. */
+    int64 MeasureHeap(const FMemoryMeasurePlan& Plan, const uint8* Container, int64* AllocatorBytes) const;
+
+    /** Heap bytes owned by the value of one step at Value. */
+    int64 MeasureStep(const FMemoryMeasureStep& Step, const uint8* Value, int64* AllocatorBytes) const;
+
+    /** Heap bytes owned by one container element of the given kind (None, String or Struct). */
+    int64 MeasureElement(EMemoryMeasureKind Kind, const FMemoryMeasurePlan* StructPlan, const uint8* Value, int64* AllocatorBytes) const;
+
+    /** Plan for container elements of ElementProperty when they are structs, else null. */
+    const FMemoryMeasurePlan* FindElementPlan(EMemoryMeasureKind Kind, const FProperty* ElementProperty) const;
+
+    /**
+     * Performs actual memory measurement for a given UObject with its class plan, filling
+     * MemoryBytes and, with bQueryAllocatorSizes, AllocatorBytes. Reads the object only, so it
+     * may run on any thread.
+     */
+    void CalculateMemoryUsage(const UObject* Object, const FMemoryMeasurePlan& Plan, FMemoryUsageInfo& OutInfo) const;
+
+    /** Fills the GetResourceSizeEx columns of OutInfo. Game thread only. */
+    static void CalculateResourceSizes(UObject* Object, FMemoryUsageInfo& OutInfo);
+
+    /**
+     * Walks the references of measured objects, in order, until every one is done (returns true)
+     * or Deadline passes (returns false). The walk in progress resumes on the next call.
+     */
+    bool WalkPendingReferences(double Deadline);
+
+    /**
+     * Starts walking the references of the tracked object PendingMemoryInfo[InfoIndex]. The walk
+     * adds the objects only it reaches to its NumReferencedObjects and moves objects another
+     * tracked object reached first to the shared bucket. Every object is claimed at most once and
+     * shared at most once per pass, so a pass costs O(graph) rather than O(roots x graph).
+     */
+    void BeginReferenceWalk(UObject* Root, int32 InfoIndex);
+
+    /** Visits up to NodeBudget queued objects of the walk in progress, deducting them. Returns true once the walk is done. */
+    bool ContinueReferenceWalk(int32& NodeBudget);
 
-    /** Helper: Recursively counts referenced objects for memory depth analysis. */
-    int32 CountReferencedObjects(UObject* Object, TSet<UObject*>& Visited) const;
+    /** Queues the objects Object references, at Depth. */
+    void PushReferences(UObject* Object, int32 Depth);
 
     /** Helper: Clears cached memory info. */
     void ClearCachedInfo();
@@ -0,0 +1,484 @@
+#include "MemoryUsageTracker.h"
+#include "MemoryUsageTrackerTestTypes.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MemoryUsageTrackerTestPrivate
+{
+    /** Heap bytes Element owns according to the containers' own GetAllocatedSize. */
+    int64 GetNativeHeapBytes(const FMemoryUsageTrackerTestElement& Element)
+    {
+        return static_cast<int64>(Element.Name.GetAllocatedSize() + Element.Values.GetAllocatedSize());
+    }
+
+    /** Heap bytes Containers owns according to the containers' own GetAllocatedSize, elements included. */
+    int64 GetNativeHeapBytes(const FMemoryUsageTrackerTestContainers& Containers)
+    {
+        int64 Bytes = static_cast<int64>(Containers.Names.GetAllocatedSize() + Containers.Elements.GetAllocatedSize()
+            + Containers.Ids.GetAllocatedSize() + Containers.Tags.GetAllocatedSize()
+            + Containers.Labels.GetAllocatedSize() + Containers.ElementsById.GetAllocatedSize());
+
+        for (const FString& Name : Containers.Names)
+        {
+            Bytes += Name.GetAllocatedSize();
+        }
+        for (const FMemoryUsageTrackerTestElement& Element : Containers.Elements)
+        {
+            Bytes += GetNativeHeapBytes(Element);
+        }
+        for (const FString& Tag : Containers.Tags)
+        {
+            Bytes += Tag.GetAllocatedSize();
+        }
+        for (const TPair<FName, FString>& Label : Containers.Labels)
+        {
+            Bytes += Label.Value.GetAllocatedSize();
+        }
+        for (const TPair<int32, FMemoryUsageTrackerTestElement>& Element : Containers.ElementsById)
+        {
+            Bytes += GetNativeHeapBytes(Element.Value);
+        }
+        return Bytes;
+    }
+
+    /** Heap bytes of a set's hash sized for NumElements, counted as the tracker does; one bucket is inline. */
+    int64 GetHashBytes(int32 NumElements)
+    {
+        const uint32 NumBuckets = FDefaultSetAllocator::GetNumberOfHashBuckets(static_cast<uint32>(NumElements));
+        return NumBuckets > 1 ? static_cast<int64>(NumBuckets) * sizeof(FSetElementId) : 0;
+    }
+
+    /**
+     * Hash bytes the tracker cannot see: every set and map of Containers has a hash sized for
+     * HashElements, while the tracker sizes it from the current element count.
+     */
+    int64 GetHashShortfall(const FMemoryUsageTrackerTestContainers& Containers, int32 HashElements)
+    {
+        return 4 * GetHashBytes(HashElements)
+            - GetHashBytes(Containers.Ids.Num()) - GetHashBytes(Containers.Tags.Num())
+            - GetHashBytes(Containers.Labels.Num()) - GetHashBytes(Containers.ElementsById.Num());
+    }
+
+    /**
+     * The allocation flags of a set or map grow on their own, while the tracker derives them from the
+     * slot capacity; the two can differ by up to the flags' size, which this bounds for Containers.
+     */
+    int64 GetFlagSlack(const FMemoryUsageTrackerTestContainers& Containers)
+    {
+        auto FlagBytes = [](int32 MaxIndex)
+        {
+            return static_cast<int64>(FMath::DivideAndRoundUp(MaxIndex + 1, 32) * sizeof(uint32));
+        };
+
+        return FlagBytes(Containers.Ids.GetMaxIndex()) + FlagBytes(Containers.Tags.GetMaxIndex())
+            + FlagBytes(Containers.Labels.GetMaxIndex()) + FlagBytes(Containers.ElementsById.GetMaxIndex());
+    }
+
+    int64 MeasureValueByReflection(const FProperty* Property, const uint8* Value);
+
+    /**
+     * Heap bytes of the struct at Container, found by walking its properties and casting each one
+     * on every call: how objects were measured before plans, kept as the benchmark baseline.
+     */
+    int64 MeasureHeapByReflection(const UStruct* Struct, const uint8* Container)
+    {
+        int64 Bytes = 0;
+        for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+        {
+            for (int32 ArrayIndex = 0; ArrayIndex < PropIt->ArrayDim; ++ArrayIndex)
+            {
+                Bytes += MeasureValueByReflection(*PropIt, PropIt->ContainerPtrToValuePtr<uint8>(Container, ArrayIndex));
+            }
+        }
+        return Bytes;
+    }
+
+    int64 MeasureValueByReflection(const FProperty* Property, const uint8* Value)
+    {
+        if (CastField<FStrProperty>(Property))
+        {
+            return reinterpret_cast<const FString*>(Value)->GetAllocatedSize();
+        }
+
+        if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+        {
+            return MeasureHeapByReflection(StructProp->Struct, Value);
+        }
+
+        int64 Bytes = 0;
+        if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper Helper(ArrayProp, Value);
+            Bytes += static_cast<int64>(reinterpret_cast<const FScriptArray*>(Value)->Max()) * ArrayProp->Inner->ElementSize;
+            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            {
+                Bytes += MeasureValueByReflection(ArrayProp->Inner, Helper.GetRawPtr(Index));
+            }
+        }
+        else if (const FSetProperty* SetProp = CastField<FSetProperty>(Property))
+        {
+            FScriptSetHelper Helper(SetProp, Value);
+            Bytes += static_cast<int64>(Helper.GetMaxIndex()) * SetProp->SetLayout.Size;
+            for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+            {
+                if (Helper.IsValidIndex(Index))
+                {
+                    Bytes += MeasureValueByReflection(SetProp->ElementProp, Helper.GetElementPtr(Index));
+                }
+            }
+        }
+        else if (const FMapProperty* MapProp = CastField<FMapProperty>(Property))
+        {
+            FScriptMapHelper Helper(MapProp, Value);
+            Bytes += static_cast<int64>(Helper.GetMaxIndex()) * MapProp->MapLayout.SetLayout.Size;
+            for (int32 Index = 0; Index < Helper.GetMaxIndex(); ++Index)
+            {
+                if (Helper.IsValidIndex(Index))
+                {
+                    Bytes += MeasureValueByReflection(MapProp->KeyProp, Helper.GetKeyPtr(Index));
+                    Bytes += MeasureValueByReflection(MapProp->ValueProp, Helper.GetValuePtr(Index));
+                }
+            }
+        }
+        return Bytes;
+    }
+
+    /** Creates NumObjects test nodes, each with NumElements entries in every container. */
+    TArray<UMemoryUsageTrackerTestNode*> MakeBenchmarkNodes(int32 NumObjects, int32 NumElements)
+    {
+        TArray<UMemoryUsageTrackerTestNode*> Nodes;
+        Nodes.Reserve(NumObjects);
+        for (int32 Index = 0; Index < NumObjects; ++Index)
+        {
+            UMemoryUsageTrackerTestNode* Node = NewObject<UMemoryUsageTrackerTestNode>(GetTransientPackage());
+            Fill(Node->Containers, NumElements);
+            Nodes.Add(Node);
+        }
+        return Nodes;
+    }
+
+    /** Best of NumRuns timings of Body, in seconds; the first run also warms the caches. */
+    double TimeBestOf(int32 NumRuns, TFunctionRef<void()> Body)
+    {
+        double Best = TNumericLimits<double>::Max();
+        for (int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            const double StartSeconds = FPlatformTime::Seconds();
+            Body();
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartSeconds);
+        }
+        return FMath::Max(Best, 1e-9);
+    }
+
+    /** Adds NumElements entries to every container, with elements of varying size. */
+    void Fill(FMemoryUsageTrackerTestContainers& Containers, int32 NumElements)
+    {
+        for (int32 Index = 0; Index < NumElements; ++Index)
+        {
+            FMemoryUsageTrackerTestElement Element;
+            Element.Name = FString::Printf(TEXT("Element_%d"), Index);
+            Element.Values.Init(Index, Index % 7 + 1);
+
+            Containers.Names.Add(FString::Printf(TEXT("Name_%d"), Index));
+            Containers.Elements.Add(Element);
+            Containers.Ids.Add(Index);
+            Containers.Tags.Add(FString::Printf(TEXT("Tag_%d"), Index));
+            Containers.Labels.Add(FName(*FString::Printf(TEXT("Label_%d"), Index)), FString::Printf(TEXT("Value_%d"), Index));
+            Containers.ElementsById.Add(Index, MoveTemp(Element));
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryUsageTrackerContainerTest, "YourProject.MemoryUsageTracker.Containers",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMemoryUsageTrackerContainerTest::RunTest(const FString& Parameters)
+{
+    using namespace MemoryUsageTrackerTestPrivate;
+
+    const UMemoryUsageTracker* Tracker = NewObject<UMemoryUsageTracker>(GetTransientPackage());
+    const FMemoryMeasurePlan& Plan = Tracker->GetMeasurePlan(FMemoryUsageTrackerTestContainers::StaticStruct());
+
+    /*
+     * Measures Containers through the plan and checks the estimate against GetAllocatedSize and
+     * against the allocator's usable sizes. GetAllocatedSize also counts the true hash sizes, so
+     * it must exceed the estimate by exactly the hash bytes of HashElements the tracker cannot see,
+     * give or take the allocation flags' own slack.
+     */
+    auto CheckEstimate = [this, Tracker, &Plan](const TCHAR* Case, const FMemoryUsageTrackerTestContainers& Containers, int32 HashElements)
+    {
+        int64 AllocatorBytes = 0;
+        const int64 Estimate = Tracker->MeasureHeap(Plan, reinterpret_cast<const uint8*>(&Containers), &AllocatorBytes);
+        const int64 Native = GetNativeHeapBytes(Containers);
+        const int64 HashShortfall = GetHashShortfall(Containers, HashElements);
+        const int64 FlagSlack = GetFlagSlack(Containers);
+
+        AddInfo(FString::Printf(TEXT("%s: estimate %lld, GetAllocatedSize %lld, hash shortfall %lld, allocator %lld bytes."),
+            Case, Estimate, Native, HashShortfall, AllocatorBytes));
+
+        TestTrue(FString::Printf(TEXT("%s: estimate misses only the hash shortfall, within %lld flag bytes"), Case, FlagSlack),
+            FMath::Abs(Native - HashShortfall - Estimate) <= FlagSlack);
+
+        // Usable sizes are never below the requested ones, and quantized container slack keeps them close
+        TestTrue(FString::Printf(TEXT("%s: allocator bytes cover the estimate"), Case), AllocatorBytes >= Estimate);
+        TestTrue(FString::Printf(TEXT("%s: allocator bytes stay within a quarter of the estimate"), Case), AllocatorBytes <= Estimate + Estimate / 4);
+    };
+
+    {
+        FMemoryUsageTrackerTestContainers Containers;
+        Fill(Containers, 200);
+
+        // Grown by adding only, so the hash matches the element count
+        CheckEstimate(TEXT("Filled"), Containers, 200);
+    }
+
+    {
+        FMemoryUsageTrackerTestContainers Containers;
+        Containers.Names.Reserve(1024);
+        Containers.Elements.Reserve(1024);
+        Containers.Ids.Reserve(1024);
+        Containers.Tags.Reserve(1024);
+        Containers.Labels.Reserve(1024);
+        Containers.ElementsById.Reserve(1024);
+        Fill(Containers, 16);
+
+        // Slack must be counted; only the hashes reserved for 1024 elements are missed
+        CheckEstimate(TEXT("Reserved"), Containers, 1024);
+    }
+
+    {
+        FMemoryUsageTrackerTestContainers Containers;
+        Fill(Containers, 400);
+        for (int32 Index = 0; Index < 400; ++Index)
+        {
+            if (Index % 4 != 0)
+            {
+                Containers.Ids.Remove(Index);
+                Containers.Tags.Remove(FString::Printf(TEXT("Tag_%d"), Index));
+                Containers.Labels.Remove(FName(*FString::Printf(TEXT("Label_%d"), Index)));
+                Containers.ElementsById.Remove(Index);
+            }
+        }
+
+        // Removed slots stay allocated; the hashes keep their size for 400 elements
+        CheckEstimate(TEXT("Removed"), Containers, 400);
+    }
+
+    {
+        UMemoryUsageTrackerTestNode* Node = NewObject<UMemoryUsageTrackerTestNode>(GetTransientPackage());
+        Fill(Node->Containers, 100);
+
+        // A class plan covers the whole instance inline, then adds the heap of its properties
+        const FMemoryMeasurePlan& NodePlan = Tracker->GetMeasurePlan(Node->GetClass());
+        TestEqual(TEXT("Class: FixedBytes is the instance size"), NodePlan.FixedBytes, static_cast<int64>(sizeof(UMemoryUsageTrackerTestNode)));
+        TestEqual(TEXT("Class: FixedBytes matches GetPropertiesSize"), NodePlan.FixedBytes, static_cast<int64>(Node->GetClass()->GetPropertiesSize()));
+
+        // Building the class plan may have moved the plans stored before it, so Plan is looked up again
+        const FMemoryMeasurePlan& ContainersPlan = Tracker->GetMeasurePlan(FMemoryUsageTrackerTestContainers::StaticStruct());
+
+        FMemoryUsageInfo Info;
+        Tracker->CalculateMemoryUsage(Node, NodePlan, Info);
+        TestEqual(TEXT("Class: estimate is FixedBytes plus the containers' heap"), Info.MemoryBytes,
+            NodePlan.FixedBytes + Tracker->MeasureHeap(ContainersPlan, reinterpret_cast<const uint8*>(&Node->Containers), nullptr));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryUsageTrackerReferenceWalkTest, "YourProject.MemoryUsageTracker.ReferenceWalk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMemoryUsageTrackerReferenceWalkTest::RunTest(const FString& Parameters)
+{
+    /*
+     * Two tracked roots share one child, and the first also heads a chain two links longer than
+     * MaxReferenceDepth, plus enough leaves that its walk spans several deadline checks:
+     *
+     *   RootA -> Shared <- RootB
+     *   RootA -> Chain[0] -> Chain[1] -> ... -> Chain[MaxDepth + 1]
+     *   RootA -> Leaves[0 .. NumLeaves)
+     */
+    constexpr int32 MaxDepth = 3;
+    constexpr int32 NumLeaves = 200;
+
+    auto MakeNode = []()
+    {
+        return NewObject<UMemoryUsageTrackerTestNode>(GetTransientPackage());
+    };
+
+    UMemoryUsageTrackerTestNode* RootA = MakeNode();
+    UMemoryUsageTrackerTestNode* RootB = MakeNode();
+    UMemoryUsageTrackerTestNode* Shared = MakeNode();
+    RootA->Children.Add(Shared);
+    RootB->Children.Add(Shared);
+
+    UMemoryUsageTrackerTestNode* Link = RootA;
+    for (int32 Index = 0; Index < MaxDepth + 2; ++Index)
+    {
+        UMemoryUsageTrackerTestNode* Next = MakeNode();
+        Link->Children.Add(Next);
+        Link = Next;
+    }
+
+    for (int32 Index = 0; Index < NumLeaves; ++Index)
+    {
+        RootA->Children.Add(MakeNode());
+    }
+
+    UMemoryUsageTracker* Tracker = NewObject<UMemoryUsageTracker>(GetTransientPackage());
+    Tracker->MaxReferenceDepth = MaxDepth;
+    Tracker->RegisterObject(RootA);
+    Tracker->RegisterObject(RootB);
+
+    auto CheckCounts = [this, Tracker, RootA, RootB](const TCHAR* Case)
+    {
+        int32 CountA = INDEX_NONE;
+        int32 CountB = INDEX_NONE;
+        for (const FMemoryUsageInfo& Info : Tracker->GetTrackedMemoryInfo())
+        {
+            if (Info.TrackedObject == RootA)
+            {
+                CountA = Info.NumReferencedObjects;
+            }
+            else if (Info.TrackedObject == RootB)
+            {
+                CountB = Info.NumReferencedObjects;
+            }
+        }
+
+        // RootA counts itself, its leaves and the chain links within MaxDepth; the shared child counts for neither root
+        TestEqual(FString::Printf(TEXT("%s: RootA references"), Case), CountA, 1 + NumLeaves + MaxDepth);
+        TestEqual(FString::Printf(TEXT("%s: RootB references"), Case), CountB, 1);
+        TestEqual(FString::Printf(TEXT("%s: shared references"), Case), Tracker->GetSharedReferencedObjectCount(), 1);
+    };
+
+    Tracker->BeginPass();
+    Tracker->ContinuePass(0.0);
+    TestFalse(TEXT("Unbudgeted pass completes at once"), Tracker->IsPassInProgress());
+    CheckCounts(TEXT("Unbudgeted"));
+
+    // A budget that is always spent stops after each slice, so the walk resumes across calls
+    Tracker->BeginPass();
+    int32 NumCalls = 0;
+    do
+    {
+        Tracker->ContinuePass(1e-9);
+        ++NumCalls;
+    }
+    while (Tracker->IsPassInProgress() && NumCalls < 1000);
+
+    TestFalse(TEXT("Time-sliced pass completes"), Tracker->IsPassInProgress());
+    CheckCounts(TEXT("Time-sliced"));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryUsageTrackerPlanBenchmark, "YourProject.MemoryUsageTracker.PlanThroughput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FMemoryUsageTrackerPlanBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace MemoryUsageTrackerTestPrivate;
+
+    constexpr int32 NumObjects = 10000;
+    constexpr int32 NumRuns = 5;
+
+    const UMemoryUsageTracker* Tracker = NewObject<UMemoryUsageTracker>(GetTransientPackage());
+
+    // From empty containers, where the per-property cost that plans remove dominates, to fuller ones
+    for (const int32 NumElements : { 0, 4, 32 })
+    {
+        const TArray<UMemoryUsageTrackerTestNode*> Nodes = MakeBenchmarkNodes(NumObjects, NumElements);
+        const UClass* NodeClass = UMemoryUsageTrackerTestNode::StaticClass();
+
+        int64 ReflectionBytes = 0;
+        const double ReflectionSeconds = TimeBestOf(NumRuns, [&Nodes, NodeClass, &ReflectionBytes]()
+        {
+            ReflectionBytes = 0;
+            for (const UMemoryUsageTrackerTestNode* Node : Nodes)
+            {
+                ReflectionBytes += NodeClass->GetPropertiesSize() + MeasureHeapByReflection(NodeClass, reinterpret_cast<const uint8*>(Node));
+            }
+        });
+
+        int64 PlanBytes = 0;
+        const double PlanSeconds = TimeBestOf(NumRuns, [Tracker, &Nodes, &PlanBytes]()
+        {
+            PlanBytes = 0;
+            for (const UMemoryUsageTrackerTestNode* Node : Nodes)
+            {
+                FMemoryUsageInfo Info;
+                Tracker->CalculateMemoryUsage(Node, Tracker->GetMeasurePlan(Node->GetClass()), Info);
+                PlanBytes += Info.MemoryBytes;
+            }
+        });
+
+        AddInfo(FString::Printf(TEXT("%d elements per container: reflection %.0f objects/ms, plans %.0f objects/ms (%.2fx); %lld vs %lld bytes."),
+            NumElements, NumObjects / (ReflectionSeconds * 1000.0), NumObjects / (PlanSeconds * 1000.0), ReflectionSeconds / PlanSeconds,
+            ReflectionBytes, PlanBytes));
+
+        // The baseline skips allocation flags and hashes, so plans can only find more
+        TestTrue(FString::Printf(TEXT("%d elements per container: plans measure at least the baseline's bytes"), NumElements), PlanBytes >= ReflectionBytes);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMemoryUsageTrackerParallelBenchmark, "YourProject.MemoryUsageTracker.ParallelThroughput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FMemoryUsageTrackerParallelBenchmark::RunTest(const FString& Parameters)
+{
+    using namespace MemoryUsageTrackerTestPrivate;
+
+    constexpr int32 NumRuns = 3;
+
+    UMemoryUsageTracker* Tracker = NewObject<UMemoryUsageTracker>(GetTransientPackage());
+
+    for (const int32 NumObjects : { 1000, 10000, 50000 })
+    {
+        const TArray<UMemoryUsageTrackerTestNode*> Nodes = MakeBenchmarkNodes(NumObjects, 4);
+
+        Tracker->PassObjects.Reset(NumObjects);
+        for (UMemoryUsageTrackerTestNode* Node : Nodes)
+        {
+            Tracker->PassObjects.Add(Node);
+        }
+
+        // Measures the whole range in one call, as an unbudgeted pass does, and sums the estimates
+        auto MeasureAll = [Tracker, NumObjects](bool bParallel, int64& OutBytes)
+        {
+            Tracker->bParallelMeasure = bParallel;
+            Tracker->PendingMemoryInfo.Reset(NumObjects);
+            Tracker->MeasurePassRange(0, NumObjects);
+
+            OutBytes = 0;
+            for (const FMemoryUsageInfo& Info : Tracker->PendingMemoryInfo)
+            {
+                OutBytes += Info.MemoryBytes;
+            }
+        };
+
+        int64 SerialBytes = 0;
+        const double SerialSeconds = TimeBestOf(NumRuns, [&MeasureAll, &SerialBytes]() { MeasureAll(false, SerialBytes); });
+
+        int64 ParallelBytes = 0;
+        const double ParallelSeconds = TimeBestOf(NumRuns, [&MeasureAll, &ParallelBytes]() { MeasureAll(true, ParallelBytes); });
+
+        AddInfo(FString::Printf(TEXT("%d objects: serial %.2f ms, ParallelFor %.2f ms (%.2fx) with batches of %d on %d workers."),
+            NumObjects, SerialSeconds * 1000.0, ParallelSeconds * 1000.0, SerialSeconds / ParallelSeconds,
+            Tracker->ParallelBatchSize, FTaskGraphInterface::Get().GetNumWorkerThreads()));
+
+        TestEqual(FString::Printf(TEXT("%d objects: serial and parallel estimates agree"), NumObjects), ParallelBytes, SerialBytes);
+    }
+
+    Tracker->PassObjects.Reset();
+    Tracker->PendingMemoryInfo.Reset();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
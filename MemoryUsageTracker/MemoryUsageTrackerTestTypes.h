@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MemoryUsageTrackerTestTypes.generated.h"
+
+/** Container element that owns heap memory of its own, for the measurement automation test. */
+USTRUCT()
+struct FMemoryUsageTrackerTestElement
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FString Name;
+
+    UPROPERTY()
+    TArray<int32> Values;
+};
+
+/** Every container kind the tracker follows, with string and struct elements. */
+USTRUCT()
+struct FMemoryUsageTrackerTestContainers
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FString> Names;
+
+    UPROPERTY()
+    TArray<FMemoryUsageTrackerTestElement> Elements;
+
+    UPROPERTY()
+    TSet<int32> Ids;
+
+    UPROPERTY()
+    TSet<FString> Tags;
+
+    UPROPERTY()
+    TMap<FName, FString> Labels;
+
+    UPROPERTY()
+    TMap<int32, FMemoryUsageTrackerTestElement> ElementsById;
+};
+
+/** Node of a synthetic object graph for the reference walk test; its containers check whole-object estimates. */
+UCLASS(Transient)
+class UMemoryUsageTrackerTestNode : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    TArray<UMemoryUsageTrackerTestNode*> Children;
+
+    UPROPERTY()
+    FMemoryUsageTrackerTestContainers Containers;
+};